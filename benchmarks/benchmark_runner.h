@@ -0,0 +1,143 @@
+#pragma once
+
+//Common helpers for the compile-time benchmark runners: compiler command
+//execution, compilation time measurement, command line parsing and
+//JSON report writing.
+
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace mcutl::benchmarks
+{
+
+struct runner_options
+{
+	std::string compiler;
+	std::string compiler_id;
+	std::string source_dir;
+	std::string work_dir = ".";
+	std::string output;
+	uint32_t repeat = 1;
+};
+
+[[nodiscard]] inline std::string quote(const std::string& value)
+{
+	return '"' + value + '"';
+}
+
+[[nodiscard]] inline std::string escape_json(const std::string& value)
+{
+	std::string result;
+	for (char ch : value)
+	{
+		if (ch == '"' || ch == '\\')
+			result += '\\';
+		result += ch;
+	}
+	return result;
+}
+
+[[nodiscard]] inline std::string get_null_device()
+{
+#ifdef _WIN32
+	return "NUL";
+#else
+	return "/dev/null";
+#endif
+}
+
+//Runs the command, discarding its output. Returns true if the command succeeded.
+[[nodiscard]] inline bool run_command(const std::string& command)
+{
+	return system((command + " > " + get_null_device() + " 2>&1").c_str()) == 0;
+}
+
+//Calls compile() options.repeat times and stores the fastest time to compile_time_ms.
+//Returns false as soon as a compilation fails.
+template<typename Compile>
+[[nodiscard]] bool measure_compile_time(const runner_options& options,
+	Compile compile, uint64_t& compile_time_ms)
+{
+	for (uint32_t i = 0; i != options.repeat; ++i)
+	{
+		auto start = std::chrono::steady_clock::now();
+		if (!compile())
+			return false;
+		
+		auto elapsed = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - start).count());
+		if (!i || elapsed < compile_time_ms)
+			compile_time_ms = elapsed;
+	}
+	
+	return true;
+}
+
+//Parses the common runner options. parse_flag(arg) is called first for each
+//argument and returns true if it accepts a runner-specific flag without a value.
+template<typename FlagParser>
+[[nodiscard]] bool parse_options(int argc, char* argv[], runner_options& options,
+	FlagParser parse_flag)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+		if (parse_flag(arg))
+			continue;
+		
+		if (i + 1 == argc)
+			return false;
+		
+		const std::string value = argv[++i];
+		if (arg == "--compiler")
+			options.compiler = value;
+		else if (arg == "--compiler-id")
+			options.compiler_id = value;
+		else if (arg == "--source-dir")
+			options.source_dir = value;
+		else if (arg == "--work-dir")
+			options.work_dir = value;
+		else if (arg == "--output")
+			options.output = value;
+		else if (arg == "--repeat")
+			options.repeat = (std::max)(1, atoi(value.c_str()));
+		else
+			return false;
+	}
+	
+	return !options.compiler.empty() && !options.source_dir.empty();
+}
+
+[[nodiscard]] inline bool parse_options(int argc, char* argv[], runner_options& options)
+{
+	return parse_options(argc, argv, options, [] (const std::string&) { return false; });
+}
+
+//Writes the report header and one line per result. write_result(out, result)
+//writes the fields of a single result.
+template<typename Result, typename ResultWriter>
+void write_report(const runner_options& options, const std::vector<Result>& results,
+	ResultWriter write_result)
+{
+	std::ofstream out(options.output);
+	out << "{\n";
+	out << "\t\"compiler\": \"" << escape_json(options.compiler) << "\",\n";
+	out << "\t\"compiler_id\": \"" << escape_json(options.compiler_id) << "\",\n";
+	out << "\t\"results\": [\n";
+	for (size_t i = 0; i != results.size(); ++i)
+	{
+		out << "\t\t{ ";
+		write_result(out, results[i]);
+		out << " }" << (i + 1 != results.size() ? "," : "") << '\n';
+	}
+	out << "\t]\n";
+	out << "}\n";
+}
+
+} //namespace mcutl::benchmarks
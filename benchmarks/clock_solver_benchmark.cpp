@@ -0,0 +1,22 @@
+//Compiled by the clock solver benchmark runner once for each device and configuration.
+//The device macro and MCUTL_CLOCK_BENCHMARK_CONFIG index are passed on the command line.
+#define STM32F1
+
+#include <stdio.h>
+
+#include "benchmarks/clock_solver_configs.h"
+
+namespace
+{
+
+constexpr auto best_tree = mcutl::clock::get_best_clock_tree<
+	mcutl::benchmarks::clock_benchmark_config_t<MCUTL_CLOCK_BENCHMARK_CONFIG>>();
+static_assert(best_tree.is_valid(), "Benchmark clock configuration is not valid");
+
+} //namespace
+
+int main()
+{
+	printf("%zu %zu\n", best_tree.get_tree_count(), best_tree.get_processed_tree_count());
+	return 0;
+}
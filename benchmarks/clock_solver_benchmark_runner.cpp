@@ -0,0 +1,181 @@
+//Clock solver compile-time benchmark runner.
+//Compiles clock_solver_benchmark.cpp for each device and clock configuration
+//from clock_solver_configs.h, measures the compilation time and optionally
+//probes the count of constexpr evaluation steps, then writes a JSON report.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmarks/benchmark_runner.h"
+#include "benchmarks/clock_solver_configs.h"
+
+namespace
+{
+
+using namespace mcutl::benchmarks;
+
+struct clock_runner_options : runner_options
+{
+	bool probe_steps = false;
+};
+
+struct benchmark_result
+{
+	std::string device;
+	std::string config;
+	bool compiled = false;
+	uint64_t compile_time_ms = 0;
+	uint64_t tree_count = 0;
+	uint64_t processed_tree_count = 0;
+	uint64_t constexpr_steps = 0;
+};
+
+[[nodiscard]] std::string get_compile_command(const clock_runner_options& options,
+	const std::string& device, size_t config_index, const std::string& extra_flags)
+{
+	return quote(options.compiler) + " -std=c++17 -I" + quote(options.source_dir)
+		+ " -D" + device + " -DMCUTL_CLOCK_BENCHMARK_CONFIG=" + std::to_string(config_index)
+		+ ' ' + extra_flags + ' '
+		+ quote(options.source_dir + "/benchmarks/clock_solver_benchmark.cpp");
+}
+
+[[nodiscard]] std::string get_steps_flag(const clock_runner_options& options, uint64_t limit)
+{
+	if (options.compiler_id == "Clang" || options.compiler_id == "AppleClang")
+		return "-fconstexpr-steps=" + std::to_string(limit);
+	
+	return "-fconstexpr-ops-limit=" + std::to_string(limit);
+}
+
+//Finds the smallest constexpr operations limit the configuration compiles with,
+//to about 1/64 precision. Returns 0 if no limit up to 2^40 is enough.
+[[nodiscard]] uint64_t probe_constexpr_steps(const clock_runner_options& options,
+	const std::string& device, size_t config_index)
+{
+	auto compiles = [&] (uint64_t limit) {
+		return run_command(get_compile_command(options, device, config_index,
+			"-fsyntax-only " + get_steps_flag(options, limit)));
+	};
+	
+	uint64_t low = 0, high = 1ull << 16;
+	while (!compiles(high))
+	{
+		low = high;
+		high *= 2u;
+		if (high > (1ull << 40))
+			return 0;
+	}
+	
+	while (high - low > high / 64u)
+	{
+		auto middle = low + (high - low) / 2u;
+		if (compiles(middle))
+			high = middle;
+		else
+			low = middle;
+	}
+	
+	return high;
+}
+
+[[nodiscard]] benchmark_result run_benchmark(const clock_runner_options& options,
+	const std::string& device, size_t config_index)
+{
+	benchmark_result result;
+	result.device = device;
+	result.config = mcutl::benchmarks::clock_benchmark_configs[config_index];
+	
+	const auto executable = options.work_dir + "/clock_" + device + '_' + std::to_string(config_index);
+	const auto command = get_compile_command(options, device, config_index, "-o " + quote(executable));
+	if (!measure_compile_time(options, [&command] { return run_command(command); },
+		result.compile_time_ms))
+	{
+		return result;
+	}
+	
+	const auto report = executable + ".txt";
+	if (system((quote(executable) + " > " + quote(report)).c_str()) != 0)
+		return result;
+	
+	std::ifstream report_stream(report);
+	if (!(report_stream >> result.tree_count >> result.processed_tree_count))
+		return result;
+	
+	result.compiled = true;
+	if (options.probe_steps)
+		result.constexpr_steps = probe_constexpr_steps(options, device, config_index);
+	
+	return result;
+}
+
+void write_result(std::ostream& out, const clock_runner_options& options,
+	const benchmark_result& result)
+{
+	out << "\"device\": \"" << result.device
+		<< "\", \"config\": \"" << result.config
+		<< "\", \"compiled\": " << (result.compiled ? "true" : "false")
+		<< ", \"compile_time_ms\": " << result.compile_time_ms
+		<< ", \"tree_count\": " << result.tree_count
+		<< ", \"processed_tree_count\": " << result.processed_tree_count;
+	if (options.probe_steps)
+		out << ", \"constexpr_steps\": " << result.constexpr_steps;
+}
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+	clock_runner_options options;
+	options.output = "clock_solver_benchmark.json";
+	auto parse_flag = [&options] (const std::string& arg) {
+		if (arg != "--probe-steps")
+			return false;
+		
+		options.probe_steps = true;
+		return true;
+	};
+	
+	if (!parse_options(argc, argv, options, parse_flag))
+	{
+		std::cerr << "Usage: " << argv[0] << " --compiler <path> --source-dir <dir>"
+			" [--compiler-id <GNU|Clang>] [--work-dir <dir>] [--output <file>]"
+			" [--repeat <count>] [--probe-steps]\n";
+		return 2;
+	}
+	
+	std::vector<benchmark_result> results;
+	bool all_compiled = true;
+	for (const char* device : mcutl::benchmarks::clock_benchmark_devices)
+	{
+		for (size_t i = 0; i != std::size(mcutl::benchmarks::clock_benchmark_configs); ++i)
+		{
+			results.push_back(run_benchmark(options, device, i));
+			const auto& result = results.back();
+			std::cout << result.device << ' ' << result.config << ": ";
+			if (result.compiled)
+			{
+				std::cout << result.compile_time_ms << " ms, "
+					<< result.processed_tree_count << '/' << result.tree_count << " trees processed";
+				if (options.probe_steps)
+					std::cout << ", " << result.constexpr_steps << " constexpr steps";
+				std::cout << '\n';
+			}
+			else
+			{
+				std::cout << "FAILED\n";
+				all_compiled = false;
+			}
+		}
+	}
+	
+	write_report(options, results, [&options] (std::ostream& out, const benchmark_result& result) {
+		write_result(out, options, result);
+	});
+	return all_compiled ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <iterator>
+#include <stddef.h>
+
+namespace mcutl::benchmarks
+{
+
+//Devices the clock module can be compiled for. STM32F101 headers lack USB
+//definitions used by the STM32F1 clock implementation, and the connectivity
+//line is not supported yet.
+[[maybe_unused]] constexpr const char* clock_benchmark_devices[] {
+	"STM32F102x6",
+	"STM32F102xB",
+	"STM32F103x6",
+	"STM32F103xB",
+	"STM32F103xE",
+	"STM32F103xG"
+};
+
+//Names of configurations defined below, in the same order
+[[maybe_unused]] constexpr const char* clock_benchmark_configs[] {
+	"hsi",
+	"hsi_lowest",
+	"hse_8mhz",
+	"hse_8mhz_lowest",
+	"hse_hsi",
+	"hse_hsi_usb",
+	"hse_12mhz_peripherals",
+	"bypass_25mhz_hsi_core_limits_lowest"
+};
+
+} //namespace mcutl::benchmarks
+
+#ifdef MCUTL_CLOCK_BENCHMARK_CONFIG
+
+#include "mcutl/clock/clock.h"
+
+namespace mcutl::benchmarks
+{
+
+using namespace mcutl::clock::literals;
+
+template<size_t Index>
+struct clock_benchmark_config;
+
+template<>
+struct clock_benchmark_config<0>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::internal_high_speed_crystal
+	>;
+};
+
+template<>
+struct clock_benchmark_config<1>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::internal_high_speed_crystal,
+		mcutl::clock::set_lowest_possible_frequencies
+	>;
+};
+
+template<>
+struct clock_benchmark_config<2>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>
+	>;
+};
+
+template<>
+struct clock_benchmark_config<3>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::set_lowest_possible_frequencies
+	>;
+};
+
+template<>
+struct clock_benchmark_config<4>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::internal_high_speed_crystal
+	>;
+};
+
+template<>
+struct clock_benchmark_config<5>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::internal_high_speed_crystal,
+		mcutl::clock::provide_usb_frequency
+	>;
+};
+
+template<>
+struct clock_benchmark_config<6>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<12_MHz>,
+		mcutl::clock::spi1<mcutl::clock::max_frequency<1_MHz>>,
+		mcutl::clock::adc<mcutl::clock::min_frequency<8_MHz>>,
+		mcutl::clock::apb1<mcutl::clock::max_frequency<24_MHz>>
+	>;
+};
+
+template<>
+struct clock_benchmark_config<7>
+{
+	using type = mcutl::clock::config<
+		mcutl::clock::external_high_speed_bypass<25_MHz>,
+		mcutl::clock::internal_high_speed_crystal,
+		mcutl::clock::core<mcutl::clock::min_frequency<24_MHz>>,
+		mcutl::clock::set_lowest_possible_frequencies
+	>;
+};
+
+static_assert(std::size(clock_benchmark_configs) == 8u,
+	"Define a clock_benchmark_config specialization for each configuration");
+
+template<size_t Index>
+using clock_benchmark_config_t = typename clock_benchmark_config<Index>::type;
+
+} //namespace mcutl::benchmarks
+
+#endif //MCUTL_CLOCK_BENCHMARK_CONFIG
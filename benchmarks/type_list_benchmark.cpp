@@ -0,0 +1,65 @@
+//Compiled by the type list benchmark runner once for each list length.
+//The MCUTL_TYPE_LIST_BENCHMARK_LENGTH value is passed on the command line.
+#include <stddef.h>
+#include <type_traits>
+#include <utility>
+
+#include "mcutl/utils/type_helpers.h"
+
+namespace
+{
+
+constexpr size_t length = MCUTL_TYPE_LIST_BENCHMARK_LENGTH;
+static_assert(length > 1, "Benchmark list must contain at least two elements");
+
+template<size_t Index>
+struct element {};
+
+template<typename Indices>
+struct element_list {};
+
+template<size_t... Indices>
+struct element_list<std::index_sequence<Indices...>>
+{
+	using type = mcutl::types::list<element<Indices>...>;
+};
+
+template<typename List>
+struct has_duplicates {};
+
+template<typename... Types>
+struct has_duplicates<mcutl::types::list<Types...>>
+	: std::bool_constant<mcutl::types::has_duplicates_v<Types...>>
+{
+};
+
+using elements = typename element_list<std::make_index_sequence<length>>::type;
+using first = element<0>;
+using last = element<length - 1>;
+
+static_assert(mcutl::types::type_index_v<last, elements> == length - 1);
+static_assert(std::is_same_v<mcutl::types::type_by_index_t<length - 1, elements>, last>);
+static_assert(mcutl::types::has_type_v<last, elements>);
+static_assert(!mcutl::types::has_type_v<element<length>, elements>);
+
+static_assert(!has_duplicates<elements>::value);
+static_assert(has_duplicates<mcutl::types::push_back_t<elements, first>>::value);
+
+using popped = mcutl::types::pop_back_t<elements>;
+static_assert(popped::length == length - 1);
+static_assert(std::is_same_v<mcutl::types::push_back_t<popped, last>, elements>);
+
+using removed = mcutl::types::remove_from_container_t<first, elements>;
+static_assert(std::is_same_v<removed, mcutl::types::pop_front_t<elements>>);
+
+using merged = mcutl::types::merge_containers_t<mcutl::types::list,
+	elements, elements, elements, elements>;
+static_assert(merged::length == length * 4);
+static_assert(std::is_same_v<mcutl::types::type_by_index_t<length * 4 - 1, merged>, last>);
+
+} //namespace
+
+int main()
+{
+	return 0;
+}
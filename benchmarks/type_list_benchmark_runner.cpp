@@ -0,0 +1,113 @@
+//Type list algorithms compile-time benchmark runner.
+//Compiles type_list_benchmark.cpp for each list length, measures the compilation
+//time and the smallest template instantiation depth it compiles with,
+//then writes a JSON report.
+
+#include <stdint.h>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "benchmarks/benchmark_runner.h"
+
+namespace
+{
+
+using namespace mcutl::benchmarks;
+
+constexpr uint32_t list_lengths[] { 64, 128, 192, 256 };
+constexpr uint32_t max_template_depth = 4096;
+
+struct benchmark_result
+{
+	uint32_t length = 0;
+	bool compiled = false;
+	uint64_t compile_time_ms = 0;
+	uint32_t template_depth = 0;
+};
+
+[[nodiscard]] bool compiles(const runner_options& options, uint32_t length, uint32_t template_depth)
+{
+	const auto command = quote(options.compiler) + " -std=c++17 -fsyntax-only -I" + quote(options.source_dir)
+		+ " -DMCUTL_TYPE_LIST_BENCHMARK_LENGTH=" + std::to_string(length)
+		+ " -ftemplate-depth=" + std::to_string(template_depth) + ' '
+		+ quote(options.source_dir + "/benchmarks/type_list_benchmark.cpp");
+	return run_command(command);
+}
+
+//Finds the smallest template instantiation depth the list length compiles with
+[[nodiscard]] uint32_t probe_template_depth(const runner_options& options, uint32_t length)
+{
+	uint32_t low = 0, high = max_template_depth;
+	while (high - low > 1)
+	{
+		auto middle = low + (high - low) / 2u;
+		if (compiles(options, length, middle))
+			high = middle;
+		else
+			low = middle;
+	}
+	
+	return high;
+}
+
+[[nodiscard]] benchmark_result run_benchmark(const runner_options& options, uint32_t length)
+{
+	benchmark_result result;
+	result.length = length;
+	if (!measure_compile_time(options,
+		[&options, length] { return compiles(options, length, max_template_depth); },
+		result.compile_time_ms))
+	{
+		return result;
+	}
+	
+	result.compiled = true;
+	result.template_depth = probe_template_depth(options, length);
+	return result;
+}
+
+void write_result(std::ostream& out, const benchmark_result& result)
+{
+	out << "\"length\": " << result.length
+		<< ", \"compiled\": " << (result.compiled ? "true" : "false")
+		<< ", \"compile_time_ms\": " << result.compile_time_ms
+		<< ", \"template_depth\": " << result.template_depth;
+}
+
+} //namespace
+
+int main(int argc, char* argv[])
+{
+	runner_options options;
+	options.output = "type_list_benchmark.json";
+	if (!parse_options(argc, argv, options))
+	{
+		std::cerr << "Usage: " << argv[0] << " --compiler <path> --source-dir <dir>"
+			" [--compiler-id <GNU|Clang>] [--output <file>] [--repeat <count>]\n";
+		return 2;
+	}
+	
+	std::vector<benchmark_result> results;
+	bool all_compiled = true;
+	for (auto length : list_lengths)
+	{
+		results.push_back(run_benchmark(options, length));
+		const auto& result = results.back();
+		std::cout << result.length << " types: ";
+		if (result.compiled)
+		{
+			std::cout << result.compile_time_ms << " ms, template depth "
+				<< result.template_depth << '\n';
+		}
+		else
+		{
+			std::cout << "FAILED\n";
+			all_compiled = false;
+		}
+	}
+	
+	write_report(options, results, write_result);
+	return all_compiled ? 0 : 1;
+}
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <array>
+#include <stddef.h>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
 #include "mcutl/clock/clock_defs.h"
 #include "mcutl/device/clock/device_clock.h"
+#include "mcutl/memory/bus_cost.h"
 #include "mcutl/utils/definitions.h"
 #include "mcutl/utils/type_helpers.h"
 
@@ -171,6 +175,65 @@ void configure_clocks() MCUTL_NOEXCEPT
 	mcutl::device::clock::configure_clocks(lambdas.first, lambdas.second);
 }
 
+template<typename ClockOptions>
+class clock_startup;
+
+template<typename ClockOptions>
+[[nodiscard]] clock_startup<ClockOptions> start_clocks() MCUTL_NOEXCEPT;
+
+//Handle of the clock configuration started by start_clocks()
+template<typename ClockOptions>
+class clock_startup
+{
+public:
+	//Performs the configuration steps which do not require waiting.
+	//Returns true when the clocks are configured.
+	bool poll() MCUTL_NOEXCEPT
+	{
+		constexpr auto lambdas = detail::unpack_options<ClockOptions>::get_option_lambdas();
+		return mcutl::device::clock::poll_clocks(lambdas.first, lambdas.second, state_);
+	}
+	
+	//Waits until the clocks are configured
+	void complete() MCUTL_NOEXCEPT
+	{
+		while (!poll())
+		{
+		}
+	}
+	
+	[[nodiscard]] bool is_complete() const noexcept
+	{
+		return state_.stage == mcutl::device::clock::clock_startup_stage::complete;
+	}
+	
+private:
+	explicit clock_startup(const mcutl::device::clock::clock_startup_state& state) noexcept
+		: state_(state)
+	{
+	}
+	
+	friend clock_startup start_clocks<ClockOptions>() MCUTL_NOEXCEPT;
+	
+private:
+	mcutl::device::clock::clock_startup_state state_;
+};
+
+//Starts the oscillators and the PLL required by the clock configuration and returns
+//without waiting for them. The configuration is completed by the returned handle.
+template<typename ClockOptions>
+clock_startup<ClockOptions> start_clocks() MCUTL_NOEXCEPT
+{
+	constexpr auto lambdas = detail::unpack_options<ClockOptions>::get_option_lambdas();
+	return clock_startup<ClockOptions>(mcutl::device::clock::start_clocks(lambdas.first, lambdas.second));
+}
+
+template<typename ClockOptions>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost configure_clocks_cost_v
+	= mcutl::device::clock::get_configure_clocks_cost(
+		detail::unpack_options<ClockOptions>::get_option_lambdas().first,
+		detail::unpack_options<ClockOptions>::get_option_lambdas().second);
+
 template<typename OldClockOptions, typename NewClockOptions>
 void reconfigure_clocks() MCUTL_NOEXCEPT
 {
@@ -180,6 +243,30 @@ void reconfigure_clocks() MCUTL_NOEXCEPT
 		new_lambdas.first, new_lambdas.second);
 }
 
+//Clock configuration to switch to when the clock security system detects an HSE failure.
+//It is clocked by the internal oscillator, and its frequencies do not exceed the ones of ClockOptions.
+template<typename ClockOptions>
+using hse_failure_fallback_config_t = decltype(mcutl::device::clock::get_hse_failure_fallback_config(
+	detail::unpack_options<ClockOptions>::get_option_lambdas().first,
+	detail::unpack_options<ClockOptions>::get_option_lambdas().second));
+
+[[nodiscard]] inline bool is_hse_failure_detected() MCUTL_NOEXCEPT
+{
+	return mcutl::device::clock::is_hse_failure_detected();
+}
+
+//Switches the clocks from ClockOptions to hse_failure_fallback_config_t<ClockOptions>
+//after an HSE failure. Call this from the NMI handler.
+template<typename ClockOptions>
+void switch_to_hse_failure_fallback() MCUTL_NOEXCEPT
+{
+	constexpr auto lambdas = detail::unpack_options<ClockOptions>::get_option_lambdas();
+	constexpr auto fallback_lambdas = detail::unpack_options<
+		hse_failure_fallback_config_t<ClockOptions>>::get_option_lambdas();
+	mcutl::device::clock::switch_to_hse_failure_fallback(lambdas.first, lambdas.second,
+		fallback_lambdas.first, fallback_lambdas.second);
+}
+
 template<typename ClockOptions>
 [[nodiscard]] constexpr auto get_best_clock_tree() noexcept
 {
@@ -243,6 +330,148 @@ template<typename ClockOptions, auto ClockId>
 		unscaled_frequency };
 }
 
+namespace detail
+{
+
+template<typename OldClockOptions, typename NewClockOptions>
+void switch_clock_profile() MCUTL_NOEXCEPT
+{
+	if constexpr (!std::is_same_v<OldClockOptions, NewClockOptions>)
+		reconfigure_clocks<OldClockOptions, NewClockOptions>();
+}
+
+} //namespace detail
+
+//Retimes the Peripherals for the clock profile with the index provided.
+//Each of the Peripherals provides a static retime(size_t profile) function.
+template<typename... Peripherals>
+void retime_peripherals(size_t profile) MCUTL_NOEXCEPT
+{
+	(..., Peripherals::retime(profile));
+}
+
+template<typename... ClockOptions>
+class clock_profile_set
+{
+public:
+	static constexpr size_t profile_count = sizeof...(ClockOptions);
+	static_assert(profile_count != 0, "Clock profile set must contain at least one configuration");
+	
+	template<size_t Index>
+	using profile_t = std::tuple_element_t<Index, std::tuple<ClockOptions...>>;
+	
+public:
+	//initial_profile is the index of the profile which is currently configured
+	explicit constexpr clock_profile_set(size_t initial_profile = 0) noexcept
+		: current_profile_(initial_profile)
+	{
+	}
+	
+	//Configures the clocks from an unknown state using the Profile configuration
+	template<size_t Profile>
+	void configure() MCUTL_NOEXCEPT
+	{
+		configure_clocks<profile_t<Profile>>();
+		current_profile_ = Profile;
+	}
+	
+	//Switches the clocks from the current profile to the profile with the index provided.
+	//Does nothing if the index is out of range.
+	void switch_to(size_t profile) MCUTL_NOEXCEPT
+	{
+		if (profile >= profile_count)
+			return;
+		
+		switch_profile(current_profile_, profile);
+		current_profile_ = profile;
+	}
+	
+	template<size_t Profile>
+	void switch_to() MCUTL_NOEXCEPT
+	{
+		static_assert(Profile < profile_count, "Invalid clock profile index");
+		switch_to(Profile);
+	}
+	
+	//Switches the clocks to the profile with the index provided and retimes the Peripherals.
+	//Peripherals with an increasing input clock frequency are retimed before the switch,
+	//the other ones are retimed after it, so the peripheral output frequencies
+	//never exceed the ones of the both profiles during the transition.
+	//Does nothing if the index is out of range.
+	template<typename... Peripherals>
+	void switch_to_and_retime(size_t profile) MCUTL_NOEXCEPT
+	{
+		static_assert((... && std::is_same_v<typename Peripherals::profile_set_type, clock_profile_set>),
+			"Peripherals must be retimed using the same clock profile set");
+		
+		if (profile >= profile_count)
+			return;
+		
+		const auto from = current_profile_;
+		(..., retime_before_switch<Peripherals>(from, profile));
+		switch_profile(from, profile);
+		(..., retime_after_switch<Peripherals>(from, profile));
+		current_profile_ = profile;
+	}
+	
+	template<size_t Profile, typename... Peripherals>
+	void switch_to_and_retime() MCUTL_NOEXCEPT
+	{
+		static_assert(Profile < profile_count, "Invalid clock profile index");
+		switch_to_and_retime<Peripherals...>(Profile);
+	}
+	
+	[[nodiscard]] constexpr size_t get_current_profile() const noexcept
+	{
+		return current_profile_;
+	}
+	
+	//Switches the clocks between two profiles without tracking the current one
+	static void switch_profile(size_t from, size_t to) MCUTL_NOEXCEPT
+	{
+		transitions_[from][to]();
+	}
+	
+private:
+	template<typename Peripheral>
+	static void retime_before_switch(size_t from, size_t to) MCUTL_NOEXCEPT
+	{
+		if (Peripheral::get_input_frequency(to) > Peripheral::get_input_frequency(from))
+			Peripheral::retime(to);
+	}
+	
+	template<typename Peripheral>
+	static void retime_after_switch(size_t from, size_t to) MCUTL_NOEXCEPT
+	{
+		if (Peripheral::get_input_frequency(to) <= Peripheral::get_input_frequency(from))
+			Peripheral::retime(to);
+	}
+	
+private:
+	using transition_t = void(*)() MCUTL_NOEXCEPT;
+	using transition_row_t = std::array<transition_t, profile_count>;
+	
+	template<size_t From, size_t... To>
+	static constexpr transition_row_t get_transition_row(std::index_sequence<To...>) noexcept
+	{
+		return { &detail::switch_clock_profile<profile_t<From>, profile_t<To>>... };
+	}
+	
+	template<size_t... From>
+	static constexpr auto get_transition_table(std::index_sequence<From...>) noexcept
+	{
+		return std::array<transition_row_t, profile_count> {
+			get_transition_row<From>(std::make_index_sequence<profile_count>())... };
+	}
+	
+	//Each transition is generated by reconfigure_clocks for its pair of profiles,
+	//so it only touches the changed clocks and keeps the flash latency ordering
+	static constexpr auto transitions_ = get_transition_table(std::make_index_sequence<profile_count>());
+	
+private:
+	size_t current_profile_;
+};
+
 template<typename OldClockOptions, typename NewClockOptions>
 using overridden_options_t = decltype(detail::override_options(std::declval<OldClockOptions>(),
 	std::declval<NewClockOptions>()));
@@ -553,6 +553,56 @@ private:
 	const clock_source& source_;
 };
 
+//Range of frequencies a clock source can output with the currently selected chain of parents.
+//It is calculated without considering the sibling sources, so the actual set
+//of frequencies available to the source is always a subset of this range.
+class chain_frequency_range
+{
+public:
+	enum class state : uint8_t
+	{
+		unknown,
+		unreachable,
+		infeasible,
+		feasible
+	};
+
+public:
+	constexpr chain_frequency_range() noexcept {}
+
+	constexpr chain_frequency_range(state value) noexcept
+		: state_(value)
+	{
+	}
+
+	constexpr chain_frequency_range(uint64_t min_frequency, uint64_t max_frequency) noexcept
+		: state_(min_frequency <= max_frequency ? state::feasible : state::infeasible)
+		, min_frequency_(min_frequency)
+		, max_frequency_(max_frequency)
+	{
+	}
+
+	constexpr state get_state() const noexcept
+	{
+		return state_;
+	}
+
+	constexpr uint64_t get_min_frequency() const noexcept
+	{
+		return min_frequency_;
+	}
+
+	constexpr uint64_t get_max_frequency() const noexcept
+	{
+		return max_frequency_;
+	}
+
+private:
+	state state_ = state::unknown;
+	uint64_t min_frequency_ = 0u;
+	uint64_t max_frequency_ = 0u;
+};
+
 using source_config_list_t = std::array<clock_source_config, max_clock_sources>;
 using final_source_config_list_t = std::array<final_clock_source_config, max_clock_sources>;
 using source_relationship_list_t = std::array<clock_relationships, max_clock_sources>;
@@ -592,10 +642,24 @@ public:
 	{
 		return is_valid_;
 	}
+	
+	//Count of clock tree states (parent source combinations) enumerated
+	constexpr size_t get_tree_count() const noexcept
+	{
+		return tree_count_;
+	}
+	
+	//Count of clock tree states which were not pruned and were fully processed
+	constexpr size_t get_processed_tree_count() const noexcept
+	{
+		return processed_tree_count_;
+	}
 
 private:
 	friend class clock_tree_base;
 	bool is_valid_ = false;
+	size_t tree_count_ = 0u;
+	size_t processed_tree_count_ = 0u;
 	std::array<SourceId, max_clock_sources> source_index_to_id_{ {} };
 	std::array<size_t, max_clock_sources> source_id_to_index_{ {} };
 	final_source_config_list_t best_source_configs_{ {} };
@@ -618,7 +682,14 @@ public:
 		set_first_tree_state();
 		do
 		{
-			if (process(reqs))
+			++result.tree_count_;
+			if (!is_tree_feasible())
+				continue;
+			if (!first_tree && !can_tree_be_better(result.best_source_configs_, reqs, true))
+				continue;
+			
+			++result.processed_tree_count_;
+			if (process(reqs, first_tree ? nullptr : &result.best_source_configs_))
 			{
 				if (first_tree)
 				{
@@ -723,10 +794,157 @@ private:
 		return false;
 	}
 
+	//Returns false if the current tree can not be better than the best one,
+	//whatever frequencies are selected later. Bounds are taken either from the
+	//chain frequency ranges (before processing the tree) or from the ranges
+	//calculated by the last processing step.
+	constexpr bool can_tree_be_better(const final_source_config_list_t& best_configs,
+		frequency_requirements reqs, bool use_chain_ranges) noexcept
+	{
+		for (size_t i = 0; i != priority_count_; ++i)
+		{
+			auto source_index = frequency_priority_[i];
+			const auto bounds = use_chain_ranges
+				? get_chain_frequency_bounds(source_index)
+				: get_frequency_bounds(source_index);
+			const auto best_frequency = best_configs[source_index].get_exact_frequency();
+			if (reqs == frequency_requirements::highest)
+			{
+				if (bounds.get_max_frequency() != best_frequency)
+					return bounds.get_max_frequency() > best_frequency;
+			}
+			else
+			{
+				if (bounds.get_min_frequency() != best_frequency)
+					return bounds.get_min_frequency() < best_frequency;
+			}
+		}
+		return false;
+	}
+
+	constexpr chain_frequency_range get_frequency_bounds(size_t source_index) const noexcept
+	{
+		const auto& ranges = source_configs_[source_index].get_ranges();
+		if (ranges.exact_frequency)
+			return { ranges.exact_frequency, ranges.exact_frequency };
+
+		return { ranges.min_frequency, ranges.max_frequency };
+	}
+
+	constexpr chain_frequency_range get_chain_frequency_bounds(size_t source_index) noexcept
+	{
+		const auto range = get_chain_range(source_index);
+		if (range.get_state() == chain_frequency_range::state::feasible)
+			return range;
+
+		//Sources which are not connected to any root keep the exact frequency from their limits
+		auto exact_frequency = sources_[source_index]->get_exact_frequency();
+		return { exact_frequency, exact_frequency };
+	}
+
+	//A tree can not be valid if any of the sources connected to a root can not get
+	//a suitable frequency, as all children of a source must accept its frequency
+	constexpr bool is_tree_feasible() noexcept
+	{
+		for (size_t i = 0; i != source_count_; ++i)
+		{
+			if (get_chain_range(i).get_state() == chain_frequency_range::state::infeasible)
+				return false;
+		}
+
+		return true;
+	}
+
+	constexpr const chain_frequency_range& get_chain_range(size_t source_index) noexcept
+	{
+		auto& range = chain_ranges_[source_index];
+		if (range.get_state() != chain_frequency_range::state::unknown)
+			return range;
+
+		const auto& source = *sources_[source_index];
+		const auto& relationships = source_relationships_[source_index];
+		chain_frequency_range parent_range;
+		if (relationships.get_parent_count())
+			parent_range = get_chain_range(relationships.get_selected_parent());
+		else if (is_root(source_index))
+			parent_range = { source.get_exact_frequency(), source.get_exact_frequency() };
+		else
+			parent_range = chain_frequency_range::state::unreachable;
+
+		if (parent_range.get_state() != chain_frequency_range::state::feasible)
+		{
+			range = parent_range.get_state();
+			return range;
+		}
+
+		range = scale_chain_range(source, parent_range);
+		return range;
+	}
+
+	static constexpr chain_frequency_range scale_chain_range(const clock_source& source,
+		const chain_frequency_range& parent_range) noexcept
+	{
+		const auto& prescaler_value = source.get_prescaler();
+		const auto prescaler_count = prescaler_value.count();
+		if (!prescaler_count)
+			return chain_frequency_range::state::infeasible;
+
+		//Prescalers are monotonic, so it's enough to scale the bounds of the parent range
+		uint64_t min_frequency = (std::numeric_limits<uint64_t>::max)(), max_frequency = 0u;
+		for (size_t i = 0; i != prescaler_count; ++i)
+		{
+			auto frequency = prescaler_value.calc_child_frequency(parent_range.get_min_frequency(), i);
+			if (frequency < min_frequency)
+				min_frequency = frequency;
+			frequency = prescaler_value.calc_child_frequency(parent_range.get_max_frequency(), i);
+			if (frequency > max_frequency)
+				max_frequency = frequency;
+		}
+
+		const auto& limits = source.get_limits();
+		if (limits.min_frequency && min_frequency < limits.min_frequency)
+			min_frequency = limits.min_frequency;
+		if (limits.max_frequency && max_frequency > limits.max_frequency)
+			max_frequency = limits.max_frequency;
+
+		if (limits.exact_frequency)
+		{
+			if (limits.exact_frequency < min_frequency || limits.exact_frequency > max_frequency)
+				return chain_frequency_range::state::infeasible;
+			return { limits.exact_frequency, limits.exact_frequency };
+		}
+
+		return { min_frequency, max_frequency };
+	}
+
+	constexpr bool is_root(size_t source_index) const noexcept
+	{
+		for (size_t i = 0; i != root_count_; ++i)
+		{
+			if (roots_[i]->get_tree_index() == source_index)
+				return true;
+		}
+
+		return false;
+	}
+
+	//Chain ranges are kept between the tree states. Only the ranges of the sources
+	//which changed their parents and of all their descendants are recalculated.
+	constexpr void invalidate_chain_range(size_t source_index) noexcept
+	{
+		chain_ranges_[source_index] = {};
+		const auto& relationships = source_relationships_[source_index];
+		for (size_t ch = 0; ch != relationships.get_child_count(); ++ch)
+			invalidate_chain_range(relationships.get_child(ch));
+	}
+
 	constexpr void set_first_tree_state() noexcept
 	{
 		for (size_t i = 0; i != source_count_; ++i)
+		{
 			source_relationships_[i].reset_selected_parent();
+			chain_ranges_[i] = {};
+		}
 
 		update_children_links();
 	}
@@ -742,10 +960,17 @@ private:
 			break;
 		}
 		update_children_links();
+
+		for (size_t changed = 0; changed != source_count_ && changed <= i; ++changed)
+		{
+			if (source_relationships_[changed].get_parent_count() > 1)
+				invalidate_chain_range(changed);
+		}
 		return i < source_count_;
 	}
 
-	constexpr bool process(frequency_requirements reqs) noexcept
+	constexpr bool process(frequency_requirements reqs,
+		const final_source_config_list_t* best_configs) noexcept
 	{
 		reset_tree_cache();
 
@@ -754,6 +979,8 @@ private:
 
 		while (!is_final_tree())
 		{
+			if (best_configs && !can_tree_be_better(*best_configs, reqs, false))
+				return false;
 			if (!select_frequency(reqs))
 				return false;
 			if (!process_step())
@@ -980,6 +1207,7 @@ private:
 	size_t root_count_ = 0u, leaf_count_ = 0u, source_count_ = 0u, priority_count_ = 0u;
 	source_relationship_list_t source_relationships_{ {} };
 	source_config_list_t source_configs_{ {} };
+	std::array<chain_frequency_range, max_clock_sources> chain_ranges_{ {} };
 	std::array<size_t, max_clock_sources> frequency_priority_{ {} };
 	std::size_t priority_index_ = 0u;
 };
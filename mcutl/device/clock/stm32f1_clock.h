@@ -10,6 +10,7 @@
 #include "mcutl/clock/detail/high_speed_clock_features.h"
 #include "mcutl/clock/detail/pll_features.h"
 #include "mcutl/clock/detail/usb_features.h"
+#include "mcutl/memory/bus_cost.h"
 #include "mcutl/memory/volatile_memory.h"
 #include "mcutl/utils/definitions.h"
 #include "mcutl/utils/type_helpers.h"
@@ -60,6 +61,24 @@ struct disable_flash_programming_interface_type : std::bool_constant<Disable> {}
 using disable_flash_programming_interface = disable_flash_programming_interface_type<true>;
 using enable_flash_programming_interface = disable_flash_programming_interface_type<false>;
 
+template<bool Enable>
+struct flash_prefetch_buffer_type : std::bool_constant<Enable> {};
+
+using enable_flash_prefetch_buffer = flash_prefetch_buffer_type<true>;
+using disable_flash_prefetch_buffer = flash_prefetch_buffer_type<false>;
+
+template<bool Enable>
+struct flash_half_cycle_access_type : std::bool_constant<Enable> {};
+
+using enable_flash_half_cycle_access = flash_half_cycle_access_type<true>;
+using disable_flash_half_cycle_access = flash_half_cycle_access_type<false>;
+
+template<bool Enable>
+struct clock_security_system_type : std::bool_constant<Enable> {};
+
+using enable_clock_security_system = clock_security_system_type<true>;
+using disable_clock_security_system = clock_security_system_type<false>;
+
 namespace detail
 {
 
@@ -76,6 +95,12 @@ struct device_specific_clock_options : base_clock_options
 	frequency_limits timer1_8_9_10_11_frequency;
 	bool use_flitf = true;
 	bool flitf_option_changed = false;
+	bool flash_prefetch_buffer = true;
+	bool flash_prefetch_buffer_option_set = false;
+	bool flash_half_cycle_access = false;
+	bool flash_half_cycle_access_option_set = false;
+	bool clock_security_system = false;
+	bool clock_security_system_option_set = false;
 };
 
 template<bool Disable, typename Limits>
@@ -105,6 +130,90 @@ struct clock_option_processor<disable_flash_programming_interface_type<Disable>,
 	}
 };
 
+template<bool Enable, typename Limits>
+struct clock_option_processor<flash_prefetch_buffer_type<Enable>, Limits>
+	: base_clock_option_processor
+{
+	template<typename ClockOptions>
+	static constexpr auto process(ClockOptions clock_opts_lambda) noexcept
+	{
+		constexpr auto clock_opts = clock_opts_lambda();
+		static_assert(!clock_opts.flash_prefetch_buffer_option_set,
+			"Duplicate flash prefetch buffer options");
+		auto clock_opts_modified = clock_opts;
+		clock_opts_modified.flash_prefetch_buffer = Enable;
+		clock_opts_modified.flash_prefetch_buffer_option_set = true;
+		return clock_opts_modified;
+	}
+	
+	template<typename... ResultOptions, typename ClockOptions>
+	static constexpr auto override_options([[maybe_unused]] config<ResultOptions...> result,
+		ClockOptions overridden_options) noexcept
+	{
+		constexpr auto clock_opts = overridden_options();
+		if constexpr (clock_opts.flash_prefetch_buffer_option_set)
+			return result;
+		else
+			return config<ResultOptions..., flash_prefetch_buffer_type<Enable>>{};
+	}
+};
+
+template<bool Enable, typename Limits>
+struct clock_option_processor<flash_half_cycle_access_type<Enable>, Limits>
+	: base_clock_option_processor
+{
+	template<typename ClockOptions>
+	static constexpr auto process(ClockOptions clock_opts_lambda) noexcept
+	{
+		constexpr auto clock_opts = clock_opts_lambda();
+		static_assert(!clock_opts.flash_half_cycle_access_option_set,
+			"Duplicate flash half cycle access options");
+		auto clock_opts_modified = clock_opts;
+		clock_opts_modified.flash_half_cycle_access = Enable;
+		clock_opts_modified.flash_half_cycle_access_option_set = true;
+		return clock_opts_modified;
+	}
+	
+	template<typename... ResultOptions, typename ClockOptions>
+	static constexpr auto override_options([[maybe_unused]] config<ResultOptions...> result,
+		ClockOptions overridden_options) noexcept
+	{
+		constexpr auto clock_opts = overridden_options();
+		if constexpr (clock_opts.flash_half_cycle_access_option_set)
+			return result;
+		else
+			return config<ResultOptions..., flash_half_cycle_access_type<Enable>>{};
+	}
+};
+
+template<bool Enable, typename Limits>
+struct clock_option_processor<clock_security_system_type<Enable>, Limits>
+	: base_clock_option_processor
+{
+	template<typename ClockOptions>
+	static constexpr auto process(ClockOptions clock_opts_lambda) noexcept
+	{
+		constexpr auto clock_opts = clock_opts_lambda();
+		static_assert(!clock_opts.clock_security_system_option_set,
+			"Duplicate clock security system options");
+		auto clock_opts_modified = clock_opts;
+		clock_opts_modified.clock_security_system = Enable;
+		clock_opts_modified.clock_security_system_option_set = true;
+		return clock_opts_modified;
+	}
+	
+	template<typename... ResultOptions, typename ClockOptions>
+	static constexpr auto override_options([[maybe_unused]] config<ResultOptions...> result,
+		ClockOptions overridden_options) noexcept
+	{
+		constexpr auto clock_opts = overridden_options();
+		if constexpr (clock_opts.clock_security_system_option_set)
+			return result;
+		else
+			return config<ResultOptions..., clock_security_system_type<Enable>>{};
+	}
+};
+
 template<typename... Options, typename Limits>
 struct clock_option_processor<adc<Options...>, Limits> : base_clock_option_processor
 {
@@ -733,9 +842,24 @@ constexpr spi_options get_spi_prescaler_bits() noexcept
 	return result;
 }
 
+template<uint64_t FlitfSysFrequency>
+constexpr uint32_t get_flash_acr() noexcept
+{
+	uint32_t flash_acr = 0;
+	if constexpr (FlitfSysFrequency > 24_MHz && FlitfSysFrequency <= 48_MHz)
+		flash_acr |= FLASH_ACR_LATENCY_0;
+	else if constexpr (FlitfSysFrequency > 48_MHz)
+		flash_acr |= FLASH_ACR_LATENCY_1;
+	return flash_acr;
+}
+
+constexpr uint32_t flash_acr_mask = FLASH_ACR_LATENCY_Msk | FLASH_ACR_HLFCYA_Msk | FLASH_ACR_PRFTBE_Msk;
+
 struct device_clock_options
 {
 	uint32_t flitf_sys_frequency = 0u;
+	uint32_t flash_acr = 0u;
+	bool flash_prefetch_buffer = true;
 	uint32_t cfgr_bits = 0u;
 	uint32_t cfgr_bits_mask = 0u;
 	device_source_id sys_source = device_source_id::hsi;
@@ -745,6 +869,7 @@ struct device_clock_options
 	bool hse_used = false;
 	bool base_configuration_is_present = false;
 	bool use_external_bypass = false;
+	bool clock_security_system = false;
 	spi_options spi1_opts {};
 	spi_options spi2_opts {};
 	spi_options spi3_opts {};
@@ -766,15 +891,37 @@ constexpr device_clock_options get_clock_options(
 	
 	if constexpr (clock_options.use_flitf)
 	{
-		result.flitf_sys_frequency = best_clock_tree.get_config_by_id(
+		constexpr auto sys_frequency = best_clock_tree.get_config_by_id(
 			device_source_id::sys).get_exact_frequency();
+		constexpr bool ahb_prescaled = best_clock_tree.get_config_by_id(
+			device_source_id::ahb).get_prescaler_value() != 1u;
+		
+		static_assert(clock_options.flash_prefetch_buffer || !ahb_prescaled,
+			"Flash prefetch buffer must be enabled when AHB prescaler is used");
+		static_assert(!clock_options.flash_half_cycle_access || !ahb_prescaled,
+			"Flash half cycle access can not be used when AHB prescaler is used");
+		static_assert(!clock_options.flash_half_cycle_access
+			|| (sys_frequency <= 8_MHz && best_clock_tree.get_node_parent(device_source_id::sys)
+				!= device_source_id::pll),
+			"Flash half cycle access can only be used with SYSCLK up to 8 MHz not clocked by PLL");
+		
+		result.flitf_sys_frequency = sys_frequency;
+		result.flash_prefetch_buffer = clock_options.flash_prefetch_buffer;
+		result.flash_acr = get_flash_acr<sys_frequency>()
+			| (clock_options.flash_prefetch_buffer ? FLASH_ACR_PRFTBE : 0u)
+			| (clock_options.flash_half_cycle_access ? FLASH_ACR_HLFCYA : 0u);
 	}
 	
-	result.hse_used = best_clock_tree.get_config_by_id(device_source_id::hse).is_used()
+	constexpr bool hse_used = best_clock_tree.get_config_by_id(device_source_id::hse).is_used()
 		|| (clock_options.oscillator_options & oscillator_options_t::external_bypass)
 			== oscillator_options_t::external_bypass
 		|| (clock_options.oscillator_options & oscillator_options_t::external_crystal)
 			== oscillator_options_t::external_crystal;
+	result.hse_used = hse_used;
+	
+	static_assert(!clock_options.clock_security_system || hse_used,
+		"Clock security system can only be enabled when HSE is used");
+	result.clock_security_system = clock_options.clock_security_system;
 	
 	constexpr uint32_t hpre_bits = get_hpre_bits<best_clock_tree.get_config_by_id(
 		device_source_id::ahb).get_prescaler_value()>();
@@ -844,15 +991,79 @@ void set_spi_prescaler() MCUTL_NOEXCEPT
 	mcutl::memory::set_register_bits<SPI_CR1_BR_Msk, PrescalerBits, &SPI_TypeDef::CR1, SpiBase>();
 }
 
-template<uint64_t FlitfSysFrequency>
-constexpr uint32_t get_flash_acr() noexcept
+//Switches SYSCLK to HSI and disables PLL, HSE and USB from an unknown clock state.
+//Returns true if USB was disabled and has to be re-enabled after the configuration.
+inline bool reset_clocks_to_hsi(uint32_t& current_cfg) MCUTL_NOEXCEPT
 {
-	uint32_t flash_acr = 0;
-	if constexpr (FlitfSysFrequency > 24_MHz && FlitfSysFrequency <= 48_MHz)
-		flash_acr |= FLASH_ACR_LATENCY_0;
-	else if constexpr (FlitfSysFrequency > 48_MHz)
-		flash_acr |= FLASH_ACR_LATENCY_1;
-	return flash_acr;
+	uint32_t current_control = mcutl::memory::get_register_bits<&RCC_TypeDef::CR, RCC_BASE>();
+	
+	bool need_to_disable_usb = mcutl::memory::get_register_flag<RCC_APB1ENR_USBEN,
+		&RCC_TypeDef::APB1ENR, RCC_BASE>();
+	bool need_to_switch_sys_to_hsi = (current_cfg & (RCC_CFGR_SW | RCC_CFGR_SWS))
+		!= (RCC_CFGR_SW_HSI | RCC_CFGR_SWS_HSI);
+	bool need_to_disable_pll = static_cast<bool>(
+		current_control & (RCC_CR_PLLON | RCC_CR_PLLRDY));
+	bool need_to_disable_hse = static_cast<bool>(
+		current_control & (RCC_CR_HSEON | RCC_CR_HSERDY));
+	bool need_to_enable_hsi = (current_control & (RCC_CR_HSION | RCC_CR_HSIRDY))
+		!= (RCC_CR_HSION | RCC_CR_HSIRDY);
+	bool need_to_reset_ahb_prescaler = (current_cfg & RCC_CFGR_HPRE) != RCC_CFGR_HPRE_DIV1;
+	
+	if (need_to_disable_usb)
+	{
+		mcutl::memory::set_register_bits<RCC_APB1ENR_USBEN_Msk, ~RCC_APB1ENR_USBEN,
+			&RCC_TypeDef::APB1ENR, RCC_BASE>();
+		[[maybe_unused]] auto temp = mcutl::memory::get_register_bits<&RCC_TypeDef::APB1ENR, RCC_BASE>();
+	}
+	
+	if (need_to_enable_hsi)
+	{
+		mcutl::memory::set_register_bits<RCC_CR_HSION_Msk, RCC_CR_HSION,
+			&RCC_TypeDef::CR, RCC_BASE>();
+		while (!mcutl::memory::get_register_bits<RCC_CR_HSIRDY, &RCC_TypeDef::CR, RCC_BASE>())
+		{
+		}
+	}
+	
+	if (need_to_switch_sys_to_hsi)
+	{
+		current_cfg &= ~RCC_CFGR_SW;
+		current_cfg |= RCC_CFGR_SW_HSI;
+		mcutl::memory::set_register_value<&RCC_TypeDef::CFGR, RCC_BASE>(current_cfg);
+		while (mcutl::memory::get_register_bits<RCC_CFGR_SWS, &RCC_TypeDef::CFGR, RCC_BASE>()
+			!= RCC_CFGR_SWS_HSI)
+		{
+		}
+	}
+	
+	//The flash prefetch buffer can only be switched when AHB is not prescaled
+	if (need_to_reset_ahb_prescaler)
+	{
+		current_cfg &= ~RCC_CFGR_HPRE;
+		mcutl::memory::set_register_value<&RCC_TypeDef::CFGR, RCC_BASE>(current_cfg);
+	}
+	
+	if (need_to_disable_pll)
+	{
+		mcutl::memory::set_register_bits<RCC_CR_PLLON_Msk, ~RCC_CR_PLLON,
+			&RCC_TypeDef::CR, RCC_BASE>();
+		while (mcutl::memory::get_register_bits<RCC_CR_PLLRDY, &RCC_TypeDef::CR, RCC_BASE>())
+		{
+		}
+	}
+	
+	if (need_to_disable_hse)
+	{
+		mcutl::memory::set_register_bits<RCC_CR_HSEON_Msk | RCC_CR_CSSON_Msk,
+			~(RCC_CR_HSEON | RCC_CR_CSSON), &RCC_TypeDef::CR, RCC_BASE>();
+		while (mcutl::memory::get_register_bits<RCC_CR_HSERDY, &RCC_TypeDef::CR, RCC_BASE>())
+		{
+		}
+		mcutl::memory::set_register_bits<RCC_CR_HSEBYP_Msk, ~RCC_CR_HSEBYP,
+			&RCC_TypeDef::CR, RCC_BASE>();
+	}
+	
+	return need_to_disable_usb;
 }
 
 template<typename ClockOptionsLambda, typename BestTreeLambda>
@@ -870,78 +1081,27 @@ void configure_clocks(ClockOptionsLambda options_lambda,
 	bool need_to_disable_usb = false;
 	uint32_t current_cfg = mcutl::memory::get_register_bits<&RCC_TypeDef::CFGR, RCC_BASE>();
 	if constexpr (!clock_opts.base_configuration_is_present)
-	{
-		uint32_t current_control = mcutl::memory::get_register_bits<&RCC_TypeDef::CR, RCC_BASE>();
-		
-		need_to_disable_usb = mcutl::memory::get_register_flag<RCC_APB1ENR_USBEN,
-			&RCC_TypeDef::APB1ENR, RCC_BASE>();
-		bool need_to_switch_sys_to_hsi = (current_cfg & (RCC_CFGR_SW | RCC_CFGR_SWS))
-			!= (RCC_CFGR_SW_HSI | RCC_CFGR_SWS_HSI);
-		bool need_to_disable_pll = static_cast<bool>(
-			current_control & (RCC_CR_PLLON | RCC_CR_PLLRDY));
-		bool need_to_disable_hse = static_cast<bool>(
-			current_control & (RCC_CR_HSEON | RCC_CR_HSERDY));
-		bool need_to_enable_hsi = (current_control & (RCC_CR_HSION | RCC_CR_HSIRDY))
-			!= (RCC_CR_HSION | RCC_CR_HSIRDY);
-		
-		if (need_to_disable_usb)
-		{
-			mcutl::memory::set_register_bits<RCC_APB1ENR_USBEN_Msk, ~RCC_APB1ENR_USBEN,
-				&RCC_TypeDef::APB1ENR, RCC_BASE>();
-			[[maybe_unused]] auto temp = mcutl::memory::get_register_bits<&RCC_TypeDef::APB1ENR, RCC_BASE>();
-		}
-	
-		if (need_to_enable_hsi)
-		{
-			mcutl::memory::set_register_bits<RCC_CR_HSION_Msk, RCC_CR_HSION,
-				&RCC_TypeDef::CR, RCC_BASE>();
-			while (!mcutl::memory::get_register_bits<RCC_CR_HSIRDY, &RCC_TypeDef::CR, RCC_BASE>())
-			{
-			}
-		}
-	
-		if (need_to_switch_sys_to_hsi)
-		{
-			current_cfg &= ~RCC_CFGR_SW;
-			current_cfg |= RCC_CFGR_SW_HSI;
-			mcutl::memory::set_register_value<&RCC_TypeDef::CFGR, RCC_BASE>(current_cfg);
-			while (mcutl::memory::get_register_bits<RCC_CFGR_SWS, &RCC_TypeDef::CFGR, RCC_BASE>()
-				!= RCC_CFGR_SWS_HSI)
-			{
-			}
-		}
-	
-		if (need_to_disable_pll)
-		{
-			mcutl::memory::set_register_bits<RCC_CR_PLLON_Msk, ~RCC_CR_PLLON,
-				&RCC_TypeDef::CR, RCC_BASE>();
-			while (mcutl::memory::get_register_bits<RCC_CR_PLLRDY, &RCC_TypeDef::CR, RCC_BASE>())
-			{
-			}
-		}
-	
-		if (need_to_disable_hse)
-		{
-			mcutl::memory::set_register_bits<RCC_CR_HSEON_Msk, ~RCC_CR_HSEON,
-				&RCC_TypeDef::CR, RCC_BASE>();
-			while (mcutl::memory::get_register_bits<RCC_CR_HSERDY, &RCC_TypeDef::CR, RCC_BASE>())
-			{
-			}
-			mcutl::memory::set_register_bits<RCC_CR_HSEBYP_Msk, ~RCC_CR_HSEBYP,
-				&RCC_TypeDef::CR, RCC_BASE>();
-		}
-	}
+		need_to_disable_usb = reset_clocks_to_hsi(current_cfg);
 	
 	if constexpr (clock_opts.hse_used)
 	{
 		constexpr uint32_t cr_bits = RCC_CR_HSEON
-			| (clock_opts.use_external_bypass ? RCC_CR_HSEBYP : 0);
+			| (clock_opts.use_external_bypass ? RCC_CR_HSEBYP : 0)
+			| (clock_opts.clock_security_system ? RCC_CR_CSSON : 0);
 		mcutl::memory::set_register_bits<cr_bits, cr_bits, &RCC_TypeDef::CR, RCC_BASE>();
 		while (!mcutl::memory::get_register_bits<RCC_CR_HSERDY, &RCC_TypeDef::CR, RCC_BASE>())
 		{
 		}
 	}
 	
+	//SYSCLK is running from HSI and AHB is not prescaled at this point,
+	//so the prefetch buffer can be switched before the new AHB prescaler is set
+	if constexpr (!!clock_opts.flitf_sys_frequency)
+	{
+		mcutl::memory::set_register_bits<flash_acr_mask,
+			clock_opts.flash_acr, &FLASH_TypeDef::ACR, FLASH_R_BASE>();
+	}
+	
 	current_cfg &= ~clock_opts.cfgr_bits_mask;
 	current_cfg |= clock_opts.cfgr_bits;
 	mcutl::memory::set_register_value<&RCC_TypeDef::CFGR, RCC_BASE>(current_cfg);
@@ -954,12 +1114,6 @@ void configure_clocks(ClockOptionsLambda options_lambda,
 		}
 	}
 	
-	if constexpr (!!clock_opts.flitf_sys_frequency)
-	{
-		mcutl::memory::set_register_bits<FLASH_ACR_LATENCY_Msk,
-			get_flash_acr<clock_opts.flitf_sys_frequency>(), &FLASH_TypeDef::ACR, FLASH_R_BASE>();
-	}
-	
 	if constexpr (clock_opts.sys_source != device_source_id::hsi)
 	{
 		current_cfg = mcutl::memory::get_register_bits<&RCC_TypeDef::CFGR, RCC_BASE>();
@@ -1006,6 +1160,233 @@ void configure_clocks(ClockOptionsLambda options_lambda,
 #endif //RCC_APB1ENR_SPI3EN
 }
 
+enum class clock_startup_stage : uint8_t
+{
+	wait_hse,
+	wait_pll,
+	wait_sys,
+	complete
+};
+
+struct clock_startup_state
+{
+	clock_startup_stage stage = clock_startup_stage::complete;
+	bool need_to_reenable_usb = false;
+};
+
+//Performs the clock configuration steps which do not require waiting for the
+//oscillators, the PLL or the system clock switch. Returns true when the clocks are configured.
+template<typename ClockOptionsLambda, typename BestTreeLambda>
+bool poll_clocks(ClockOptionsLambda options_lambda,
+	BestTreeLambda best_clock_tree_lambda, clock_startup_state& state) MCUTL_NOEXCEPT
+{
+	using namespace mcutl::clock::detail;
+	
+	constexpr auto clock_opts = get_clock_options(options_lambda, best_clock_tree_lambda);
+	
+	switch (state.stage)
+	{
+	case clock_startup_stage::wait_hse:
+		if constexpr (clock_opts.hse_used)
+		{
+			if (!mcutl::memory::get_register_bits<RCC_CR_HSERDY, &RCC_TypeDef::CR, RCC_BASE>())
+				return false;
+		}
+		
+		//SYSCLK is running from HSI and AHB is not prescaled at this point
+		if constexpr (!!clock_opts.flitf_sys_frequency)
+		{
+			mcutl::memory::set_register_bits<flash_acr_mask,
+				clock_opts.flash_acr, &FLASH_TypeDef::ACR, FLASH_R_BASE>();
+		}
+		
+		mcutl::memory::set_register_bits<clock_opts.cfgr_bits_mask, clock_opts.cfgr_bits,
+			&RCC_TypeDef::CFGR, RCC_BASE>();
+		if constexpr (clock_opts.pll_used)
+		{
+			mcutl::memory::set_register_bits<RCC_CR_PLLON_Msk, RCC_CR_PLLON,
+				&RCC_TypeDef::CR, RCC_BASE>();
+		}
+		state.stage = clock_startup_stage::wait_pll;
+		[[fallthrough]];
+	
+	case clock_startup_stage::wait_pll:
+		if constexpr (clock_opts.pll_used)
+		{
+			if (!mcutl::memory::get_register_bits<RCC_CR_PLLRDY, &RCC_TypeDef::CR, RCC_BASE>())
+				return false;
+		}
+		
+		if constexpr (clock_opts.sys_source != device_source_id::hsi)
+		{
+			mcutl::memory::set_register_bits<RCC_CFGR_SW_Msk, get_sys_source_bits(clock_opts),
+				&RCC_TypeDef::CFGR, RCC_BASE>();
+		}
+		state.stage = clock_startup_stage::wait_sys;
+		[[fallthrough]];
+	
+	case clock_startup_stage::wait_sys:
+		if constexpr (clock_opts.sys_source != device_source_id::hsi)
+		{
+			if (mcutl::memory::get_register_bits<RCC_CFGR_SWS, &RCC_TypeDef::CFGR, RCC_BASE>()
+				== RCC_CFGR_SWS_HSI)
+			{
+				return false;
+			}
+		}
+		
+		if constexpr (clock_opts.usb_used)
+		{
+			if (state.need_to_reenable_usb)
+			{
+				mcutl::memory::set_register_bits<RCC_APB1ENR_USBEN_Msk, RCC_APB1ENR_USBEN,
+					&RCC_TypeDef::APB1ENR, RCC_BASE>();
+				[[maybe_unused]] auto temp = mcutl::memory::get_register_bits<&RCC_TypeDef::APB1ENR, RCC_BASE>();
+			}
+		}
+		
+		if constexpr (!clock_opts.hsi_used)
+		{
+			mcutl::memory::set_register_bits<RCC_CR_HSION_Msk, ~RCC_CR_HSION,
+				&RCC_TypeDef::CR, RCC_BASE>();
+		}
+		
+#ifdef RCC_APB2ENR_SPI1EN
+		if constexpr (clock_opts.spi1_opts.used)
+			set_spi_prescaler<clock_opts.spi1_opts.prescaler_bits, SPI1_BASE>();
+#endif //RCC_APB2ENR_SPI1EN
+#ifdef RCC_APB1ENR_SPI2EN
+		if constexpr (clock_opts.spi2_opts.used)
+			set_spi_prescaler<clock_opts.spi2_opts.prescaler_bits, SPI2_BASE>();
+#endif //RCC_APB1ENR_SPI2EN
+#ifdef RCC_APB1ENR_SPI3EN
+		if constexpr (clock_opts.spi3_opts.used)
+			set_spi_prescaler<clock_opts.spi3_opts.prescaler_bits, SPI3_BASE>();
+#endif //RCC_APB1ENR_SPI3EN
+		state.stage = clock_startup_stage::complete;
+		[[fallthrough]];
+	
+	default:
+		return true;
+	}
+}
+
+//Starts the oscillators and the PLL required by the configuration without
+//waiting for them to become ready. The configuration is then completed by poll_clocks().
+template<typename ClockOptionsLambda, typename BestTreeLambda>
+clock_startup_state start_clocks(ClockOptionsLambda options_lambda,
+	BestTreeLambda best_clock_tree_lambda) MCUTL_NOEXCEPT
+{
+	using namespace mcutl::clock::detail;
+	
+#if defined(STM32F105xC) || defined(STM32F107xC) //Connectivity line
+	static_assert(false, "Connectivity line is not supported yet");
+#endif //Connectivity line
+	
+	constexpr auto clock_opts = get_clock_options(options_lambda, best_clock_tree_lambda);
+	
+	clock_startup_state state;
+	if constexpr (!clock_opts.base_configuration_is_present)
+	{
+		uint32_t current_cfg = mcutl::memory::get_register_bits<&RCC_TypeDef::CFGR, RCC_BASE>();
+		state.need_to_reenable_usb = reset_clocks_to_hsi(current_cfg);
+	}
+	
+	if constexpr (clock_opts.hse_used)
+	{
+		constexpr uint32_t cr_bits = RCC_CR_HSEON
+			| (clock_opts.use_external_bypass ? RCC_CR_HSEBYP : 0)
+			| (clock_opts.clock_security_system ? RCC_CR_CSSON : 0);
+		mcutl::memory::set_register_bits<cr_bits, cr_bits, &RCC_TypeDef::CR, RCC_BASE>();
+	}
+	
+	state.stage = clock_startup_stage::wait_hse;
+	poll_clocks(options_lambda, best_clock_tree_lambda, state);
+	return state;
+}
+
+//Returns the worst case cost of configure_clocks(): if the base configuration
+//is not present, all steps required to reset the clocks to HSI are counted
+template<typename ClockOptionsLambda, typename BestTreeLambda>
+constexpr mcutl::memory::bus_cost get_configure_clocks_cost(ClockOptionsLambda options_lambda,
+	BestTreeLambda best_clock_tree_lambda) noexcept
+{
+	using namespace mcutl::clock::detail;
+	using mcutl::memory::read_cost;
+	using mcutl::memory::write_cost;
+	using mcutl::memory::poll_cost;
+	
+	constexpr auto clock_opts = get_clock_options(options_lambda, best_clock_tree_lambda);
+	constexpr auto usb_enable_cost = mcutl::memory::set_register_bits_cost_v<RCC_APB1ENR_USBEN_Msk,
+		&RCC_TypeDef::APB1ENR, RCC_BASE> + read_cost;
+	
+	mcutl::memory::bus_cost cost = read_cost;
+	if constexpr (!clock_opts.base_configuration_is_present)
+	{
+		//CR and APB1ENR reads, USB disable, HSI enable, switch to HSI, AHB prescaler reset,
+		//PLL and HSE disable
+		cost += read_cost + read_cost + usb_enable_cost;
+		cost += mcutl::memory::set_register_bits_cost_v<RCC_CR_HSION_Msk,
+			&RCC_TypeDef::CR, RCC_BASE> + poll_cost;
+		cost += write_cost + poll_cost + write_cost;
+		cost += mcutl::memory::set_register_bits_cost_v<RCC_CR_PLLON_Msk,
+			&RCC_TypeDef::CR, RCC_BASE> + poll_cost;
+		cost += mcutl::memory::set_register_bits_cost_v<RCC_CR_HSEON_Msk | RCC_CR_CSSON_Msk,
+			&RCC_TypeDef::CR, RCC_BASE> + poll_cost;
+		cost += mcutl::memory::set_register_bits_cost_v<RCC_CR_HSEBYP_Msk,
+			&RCC_TypeDef::CR, RCC_BASE>;
+	}
+	
+	if constexpr (clock_opts.hse_used)
+	{
+		constexpr uint32_t cr_bits = RCC_CR_HSEON
+			| (clock_opts.use_external_bypass ? RCC_CR_HSEBYP : 0)
+			| (clock_opts.clock_security_system ? RCC_CR_CSSON : 0);
+		cost += mcutl::memory::set_register_bits_cost_v<cr_bits,
+			&RCC_TypeDef::CR, RCC_BASE> + poll_cost;
+	}
+	
+	cost += write_cost;
+	if constexpr (clock_opts.pll_used)
+	{
+		cost += mcutl::memory::set_register_bits_cost_v<RCC_CR_PLLON_Msk,
+			&RCC_TypeDef::CR, RCC_BASE> + poll_cost;
+	}
+	
+	if constexpr (!!clock_opts.flitf_sys_frequency)
+	{
+		cost += mcutl::memory::set_register_bits_cost_v<flash_acr_mask,
+			&FLASH_TypeDef::ACR, FLASH_R_BASE>;
+	}
+	
+	if constexpr (clock_opts.sys_source != device_source_id::hsi)
+		cost += read_cost + write_cost + poll_cost;
+	
+	if constexpr (clock_opts.usb_used && !clock_opts.base_configuration_is_present)
+		cost += usb_enable_cost;
+	
+	if constexpr (!clock_opts.hsi_used)
+	{
+		cost += mcutl::memory::set_register_bits_cost_v<RCC_CR_HSION_Msk,
+			&RCC_TypeDef::CR, RCC_BASE>;
+	}
+	
+#ifdef RCC_APB2ENR_SPI1EN
+	if constexpr (clock_opts.spi1_opts.used)
+		cost += mcutl::memory::set_register_bits_cost_v<SPI_CR1_BR_Msk, &SPI_TypeDef::CR1, SPI1_BASE>;
+#endif //RCC_APB2ENR_SPI1EN
+#ifdef RCC_APB1ENR_SPI2EN
+	if constexpr (clock_opts.spi2_opts.used)
+		cost += mcutl::memory::set_register_bits_cost_v<SPI_CR1_BR_Msk, &SPI_TypeDef::CR1, SPI2_BASE>;
+#endif //RCC_APB1ENR_SPI2EN
+#ifdef RCC_APB1ENR_SPI3EN
+	if constexpr (clock_opts.spi3_opts.used)
+		cost += mcutl::memory::set_register_bits_cost_v<SPI_CR1_BR_Msk, &SPI_TypeDef::CR1, SPI3_BASE>;
+#endif //RCC_APB1ENR_SPI3EN
+	
+	return cost;
+}
+
 template<typename Options>
 constexpr bool usb_must_be_reenabled(const Options& old_clock_opts, const Options& new_clock_opts) noexcept
 {
@@ -1039,14 +1420,34 @@ constexpr bool usb_must_be_disabled(const Options& old_clock_opts, const Options
 	return pll_must_be_disabled(old_clock_opts, new_clock_opts);
 }
 
+template<typename Options>
+constexpr bool prefetch_buffer_must_be_switched(const Options& old_clock_opts,
+	const Options& new_clock_opts) noexcept
+{
+	return old_clock_opts.flitf_sys_frequency && new_clock_opts.flitf_sys_frequency
+		&& old_clock_opts.flash_prefetch_buffer != new_clock_opts.flash_prefetch_buffer;
+}
+
 template<typename Options>
 constexpr bool switch_sys_to_hsi(const Options& old_clock_opts, const Options& new_clock_opts) noexcept
 {
+	//The flash prefetch buffer can only be switched when SYSCLK is lower than 24 MHz
 	return (old_clock_opts.sys_source != new_clock_opts.sys_source
-			|| pll_must_be_disabled(old_clock_opts, new_clock_opts))
+			|| pll_must_be_disabled(old_clock_opts, new_clock_opts)
+			|| prefetch_buffer_must_be_switched(old_clock_opts, new_clock_opts))
 		&& old_clock_opts.sys_source != device_source_id::hsi;
 }
 
+//The prefetch buffer must be switched when AHB is not prescaled. If it is being enabled,
+//this is true for the old configuration, otherwise for the new one.
+template<typename Options>
+constexpr bool prefetch_buffer_must_be_enabled_early(const Options& old_clock_opts,
+	const Options& new_clock_opts) noexcept
+{
+	return prefetch_buffer_must_be_switched(old_clock_opts, new_clock_opts)
+		&& new_clock_opts.flash_prefetch_buffer;
+}
+
 template<typename Options>
 constexpr bool pll_must_be_reenabled(const Options& old_clock_opts, const Options& new_clock_opts) noexcept
 {
@@ -1127,6 +1528,15 @@ void reconfigure_clocks(OldClockOptionsLambda old_options_lambda,
 		}
 	}
 	
+	//SYSCLK is running from HSI and AHB is not prescaled by the old configuration
+	constexpr bool change_flash_acr_early = prefetch_buffer_must_be_enabled_early(
+		old_clock_opts, new_clock_opts);
+	if constexpr (change_flash_acr_early)
+	{
+		mcutl::memory::set_register_bits<flash_acr_mask,
+			new_clock_opts.flash_acr, &FLASH_TypeDef::ACR, FLASH_R_BASE>();
+	}
+	
 	if constexpr (pll_must_be_disabled(old_clock_opts, new_clock_opts))
 	{
 		mcutl::memory::set_register_bits<RCC_CR_PLLON_Msk, ~RCC_CR_PLLON,
@@ -1138,8 +1548,8 @@ void reconfigure_clocks(OldClockOptionsLambda old_options_lambda,
 	
 	if constexpr (hse_must_be_disabled(old_clock_opts, new_clock_opts))
 	{
-		mcutl::memory::set_register_bits<RCC_CR_HSEON_Msk, ~RCC_CR_HSEON,
-			&RCC_TypeDef::CR, RCC_BASE>();
+		mcutl::memory::set_register_bits<RCC_CR_HSEON_Msk | RCC_CR_CSSON_Msk,
+			~(RCC_CR_HSEON | RCC_CR_CSSON), &RCC_TypeDef::CR, RCC_BASE>();
 		while (mcutl::memory::get_register_bits<RCC_CR_HSERDY, &RCC_TypeDef::CR, RCC_BASE>())
 		{
 		}
@@ -1152,13 +1562,22 @@ void reconfigure_clocks(OldClockOptionsLambda old_options_lambda,
 	
 	if constexpr (hse_must_be_reenabled(old_clock_opts, new_clock_opts))
 	{
-		constexpr uint32_t cr_bits = RCC_CR_HSEON | (new_clock_opts.use_external_bypass ? RCC_CR_HSEBYP : 0);
+		constexpr uint32_t cr_bits = RCC_CR_HSEON
+			| (new_clock_opts.use_external_bypass ? RCC_CR_HSEBYP : 0)
+			| (new_clock_opts.clock_security_system ? RCC_CR_CSSON : 0);
 		mcutl::memory::set_register_bits<cr_bits, cr_bits, &RCC_TypeDef::CR, RCC_BASE>();
 		while (!mcutl::memory::get_register_bits<RCC_CR_HSERDY, &RCC_TypeDef::CR, RCC_BASE>())
 		{
 		}
 	}
 	
+	if constexpr (!hse_must_be_reenabled(old_clock_opts, new_clock_opts) && new_clock_opts.hse_used
+		&& old_clock_opts.clock_security_system != new_clock_opts.clock_security_system)
+	{
+		mcutl::memory::set_register_bits<RCC_CR_CSSON_Msk,
+			new_clock_opts.clock_security_system ? RCC_CR_CSSON : 0u, &RCC_TypeDef::CR, RCC_BASE>();
+	}
+	
 	if constexpr (old_clock_opts.cfgr_bits != new_clock_opts.cfgr_bits)
 	{
 		//This can change the prescalers and change the PLL source only
@@ -1175,14 +1594,16 @@ void reconfigure_clocks(OldClockOptionsLambda old_options_lambda,
 		}
 	}
 	
-	if constexpr (get_flash_acr<new_clock_opts.flitf_sys_frequency>()
-		!= get_flash_acr<old_clock_opts.flitf_sys_frequency>())
+	if constexpr (!change_flash_acr_early && new_clock_opts.flash_acr != old_clock_opts.flash_acr)
 	{
-		mcutl::memory::set_register_bits<FLASH_ACR_LATENCY_Msk,
-			get_flash_acr<new_clock_opts.flitf_sys_frequency>(), &FLASH_TypeDef::ACR, FLASH_R_BASE>();
+		mcutl::memory::set_register_bits<flash_acr_mask,
+			new_clock_opts.flash_acr, &FLASH_TypeDef::ACR, FLASH_R_BASE>();
 	}
 	
-	if constexpr (need_to_switch_sys_to_hsi && new_clock_opts.sys_source != device_source_id::hsi)
+	//SYSCLK is running from HSI at this point if it was switched to HSI above
+	//or if HSI was the system clock source in the old configuration
+	if constexpr ((need_to_switch_sys_to_hsi || old_clock_opts.sys_source != new_clock_opts.sys_source)
+		&& new_clock_opts.sys_source != device_source_id::hsi)
 	{
 		constexpr auto new_sys_source_bits = get_sys_source_bits(new_clock_opts);
 		mcutl::memory::set_register_bits<RCC_CFGR_SW_Msk, new_sys_source_bits,
@@ -1231,5 +1652,202 @@ void reconfigure_clocks(OldClockOptionsLambda old_options_lambda,
 	}
 #endif //RCC_APB1ENR_SPI3EN
 }
+
+//Appends ClockOption<max_frequency<F>> to the Options if the clock SourceId is used,
+//where F is the frequency of the clock in the best clock tree
+template<template<typename...> typename ClockOption, device_source_id SourceId,
+	bool Constrained = true, typename BestTreeLambda, typename... Options>
+constexpr auto append_max_frequency_option(BestTreeLambda best_clock_tree_lambda,
+	[[maybe_unused]] mcutl::clock::config<Options...> options) noexcept
+{
+	constexpr auto source_config = best_clock_tree_lambda().get_config_by_id(SourceId);
+	if constexpr (Constrained && source_config.is_used())
+	{
+		return mcutl::clock::config<Options...,
+			ClockOption<mcutl::clock::max_frequency<source_config.get_exact_frequency()>>>{};
+	}
+	else
+	{
+		return options;
+	}
+}
+
+//Returns the configuration to switch to when HSE fails. SYSCLK is clocked by HSI (directly or
+//through the PLL), and none of the core, bus and requested peripheral clocks exceed their frequencies
+//from the original configuration. The highest possible frequencies are chosen within these limits.
+template<typename ClockOptionsLambda, typename BestTreeLambda>
+constexpr auto get_hse_failure_fallback_config(ClockOptionsLambda options_lambda,
+	BestTreeLambda best_clock_tree_lambda) noexcept
+{
+	constexpr auto clock_options = options_lambda();
+	using base_config = std::conditional_t<clock_options.usb_required,
+		mcutl::clock::config<mcutl::clock::internal_high_speed_crystal, mcutl::clock::provide_usb_frequency>,
+		mcutl::clock::config<mcutl::clock::internal_high_speed_crystal>>;
+	
+	auto core_config = append_max_frequency_option<mcutl::clock::core, device_source_id::sys>(
+		best_clock_tree_lambda, base_config{});
+	auto ahb_config = append_max_frequency_option<mcutl::clock::ahb, device_source_id::ahb>(
+		best_clock_tree_lambda, core_config);
+	auto apb1_config = append_max_frequency_option<mcutl::clock::apb1, device_source_id::apb1>(
+		best_clock_tree_lambda, ahb_config);
+	auto apb2_config = append_max_frequency_option<mcutl::clock::apb2, device_source_id::apb2>(
+		best_clock_tree_lambda, apb1_config);
+	constexpr bool adc_constrained = clock_options.adc_frequency.has_limits();
+	auto adc_config = append_max_frequency_option<mcutl::clock::adc, device_source_id::adc, adc_constrained>(
+		best_clock_tree_lambda, apb2_config);
+	
+#ifdef RCC_APB2ENR_SPI1EN
+	auto spi1_config = append_max_frequency_option<mcutl::clock::spi1, device_source_id::spi1>(
+		best_clock_tree_lambda, adc_config);
+#else //RCC_APB2ENR_SPI1EN
+	auto spi1_config = adc_config;
+#endif //RCC_APB2ENR_SPI1EN
+#ifdef RCC_APB1ENR_SPI2EN
+	auto spi2_config = append_max_frequency_option<mcutl::clock::spi2, device_source_id::spi2>(
+		best_clock_tree_lambda, spi1_config);
+#else //RCC_APB1ENR_SPI2EN
+	auto spi2_config = spi1_config;
+#endif //RCC_APB1ENR_SPI2EN
+#ifdef RCC_APB1ENR_SPI3EN
+	auto spi3_config = append_max_frequency_option<mcutl::clock::spi3, device_source_id::spi3>(
+		best_clock_tree_lambda, spi2_config);
+#else //RCC_APB1ENR_SPI3EN
+	auto spi3_config = spi2_config;
+#endif //RCC_APB1ENR_SPI3EN
+	
+#if defined (RCC_APB1ENR_TIM2EN) || defined (RCC_APB1ENR_TIM3EN) || defined (RCC_APB1ENR_TIM4EN) \
+	|| defined (RCC_APB1ENR_TIM5EN) || defined(RCC_APB1ENR_TIM6EN) || defined(RCC_APB1ENR_TIM7EN) \
+	|| defined(RCC_APB1ENR_TIM12EN) || defined(RCC_APB1ENR_TIM13EN) || defined(RCC_APB1ENR_TIM14EN)
+	auto timer2_config = append_max_frequency_option<mcutl::clock::timer2_3_4_5_6_7_12_13_14,
+		device_source_id::timer2_3_4_5_6_7_12_13_14>(best_clock_tree_lambda, spi3_config);
+#else //RCC_APB1ENR_TIM2EN - RCC_APB1ENR_TIM7EN, RCC_APB1ENR_TIM12EN - RCC_APB1ENR_TIM14EN
+	auto timer2_config = spi3_config;
+#endif //RCC_APB1ENR_TIM2EN - RCC_APB1ENR_TIM7EN, RCC_APB1ENR_TIM12EN - RCC_APB1ENR_TIM14EN
+	
+#if defined (RCC_APB2ENR_TIM1EN) || defined (RCC_APB2ENR_TIM8EN) || defined (RCC_APB2ENR_TIM9EN) \
+	|| defined (RCC_APB2ENR_TIM10EN) || defined(RCC_APB2ENR_TIM11EN)
+	return append_max_frequency_option<mcutl::clock::timer1_8_9_10_11,
+		device_source_id::timer1_8_9_10_11>(best_clock_tree_lambda, timer2_config);
+#else //RCC_APB2ENR_TIM1EN, RCC_APB2ENR_TIM8EN - RCC_APB2ENR_TIM11EN
+	return timer2_config;
+#endif //RCC_APB2ENR_TIM1EN, RCC_APB2ENR_TIM8EN - RCC_APB2ENR_TIM11EN
+}
+
+[[nodiscard]] inline bool is_hse_failure_detected() MCUTL_NOEXCEPT
+{
+	return mcutl::memory::get_register_flag<RCC_CIR_CSSF, &RCC_TypeDef::CIR, RCC_BASE>();
+}
+
+//Switches the clocks to the fallback configuration after the clock security system
+//has detected an HSE failure. At this point the hardware has already stopped HSE and
+//switched SYSCLK to HSI, so all register values written here are precomputed constants.
+//This is intended to be called from the NMI handler.
+template<typename ClockOptionsLambda, typename BestTreeLambda,
+	typename FallbackClockOptionsLambda, typename FallbackBestTreeLambda>
+void switch_to_hse_failure_fallback(ClockOptionsLambda options_lambda,
+	BestTreeLambda best_clock_tree_lambda,
+	FallbackClockOptionsLambda fallback_options_lambda,
+	FallbackBestTreeLambda fallback_best_clock_tree_lambda) MCUTL_NOEXCEPT
+{
+	using namespace mcutl::clock::detail;
+	
+	constexpr auto clock_opts = get_clock_options(options_lambda, best_clock_tree_lambda);
+	constexpr auto fallback_clock_opts = get_clock_options(fallback_options_lambda,
+		fallback_best_clock_tree_lambda);
+	static_assert(clock_opts.clock_security_system,
+		"Clock security system is not enabled by the clock configuration");
+	
+	mcutl::memory::set_register_bits<RCC_CIR_CSSC_Msk, RCC_CIR_CSSC, &RCC_TypeDef::CIR, RCC_BASE>();
+	
+	bool need_to_reenable_usb = false;
+	if constexpr (fallback_clock_opts.usb_used)
+	{
+		need_to_reenable_usb = mcutl::memory::get_register_flag<RCC_APB1ENR_USBEN,
+			&RCC_TypeDef::APB1ENR, RCC_BASE>();
+		if (need_to_reenable_usb)
+		{
+			mcutl::memory::set_register_bits<RCC_APB1ENR_USBEN_Msk, ~RCC_APB1ENR_USBEN,
+				&RCC_TypeDef::APB1ENR, RCC_BASE>();
+			[[maybe_unused]] auto temp = mcutl::memory::get_register_bits<&RCC_TypeDef::APB1ENR, RCC_BASE>();
+		}
+	}
+	
+	//The PLL is stopped by the hardware only if it was clocked by HSE
+	if constexpr (clock_opts.pll_used)
+	{
+		if (mcutl::memory::get_register_flag<RCC_CR_PLLON, &RCC_TypeDef::CR, RCC_BASE>())
+		{
+			mcutl::memory::set_register_bits<RCC_CR_PLLON_Msk, ~RCC_CR_PLLON,
+				&RCC_TypeDef::CR, RCC_BASE>();
+			while (mcutl::memory::get_register_bits<RCC_CR_PLLRDY, &RCC_TypeDef::CR, RCC_BASE>())
+			{
+			}
+		}
+	}
+	
+	mcutl::memory::set_register_bits<RCC_CR_HSEON_Msk | RCC_CR_CSSON_Msk | RCC_CR_HSEBYP_Msk,
+		0u, &RCC_TypeDef::CR, RCC_BASE>();
+	
+	//The flash prefetch buffer can only be switched when AHB is not prescaled
+	if constexpr ((clock_opts.cfgr_bits & RCC_CFGR_HPRE) != RCC_CFGR_HPRE_DIV1)
+	{
+		mcutl::memory::set_register_bits<RCC_CFGR_HPRE_Msk, RCC_CFGR_HPRE_DIV1,
+			&RCC_TypeDef::CFGR, RCC_BASE>();
+	}
+	
+	//SYSCLK is running from HSI, so the flash latency and the prefetch buffer can be changed first
+	mcutl::memory::set_register_bits<flash_acr_mask,
+		fallback_clock_opts.flash_acr, &FLASH_TypeDef::ACR, FLASH_R_BASE>();
+	mcutl::memory::set_register_bits<fallback_clock_opts.cfgr_bits_mask | clock_opts.cfgr_bits_mask,
+		fallback_clock_opts.cfgr_bits, &RCC_TypeDef::CFGR, RCC_BASE>();
+	
+	if constexpr (fallback_clock_opts.pll_used)
+	{
+		mcutl::memory::set_register_bits<RCC_CR_PLLON_Msk, RCC_CR_PLLON,
+			&RCC_TypeDef::CR, RCC_BASE>();
+		while (!mcutl::memory::get_register_bits<RCC_CR_PLLRDY, &RCC_TypeDef::CR, RCC_BASE>())
+		{
+		}
+		
+		mcutl::memory::set_register_bits<RCC_CFGR_SW_Msk, RCC_CFGR_SW_PLL,
+			&RCC_TypeDef::CFGR, RCC_BASE>();
+		while (mcutl::memory::get_register_bits<RCC_CFGR_SWS, &RCC_TypeDef::CFGR, RCC_BASE>()
+			!= RCC_CFGR_SWS_PLL)
+		{
+		}
+	}
+	
+	if constexpr (fallback_clock_opts.usb_used)
+	{
+		if (need_to_reenable_usb)
+		{
+			mcutl::memory::set_register_bits<RCC_APB1ENR_USBEN_Msk, RCC_APB1ENR_USBEN,
+				&RCC_TypeDef::APB1ENR, RCC_BASE>();
+			[[maybe_unused]] auto temp = mcutl::memory::get_register_bits<&RCC_TypeDef::APB1ENR, RCC_BASE>();
+		}
+	}
+	
+#ifdef RCC_APB2ENR_SPI1EN
+	if constexpr (fallback_clock_opts.spi1_opts.used
+		&& fallback_clock_opts.spi1_opts.prescaler_bits != clock_opts.spi1_opts.prescaler_bits)
+	{
+		set_spi_prescaler<fallback_clock_opts.spi1_opts.prescaler_bits, SPI1_BASE>();
+	}
+#endif //RCC_APB2ENR_SPI1EN
+#ifdef RCC_APB1ENR_SPI2EN
+	if constexpr (fallback_clock_opts.spi2_opts.used
+		&& fallback_clock_opts.spi2_opts.prescaler_bits != clock_opts.spi2_opts.prescaler_bits)
+	{
+		set_spi_prescaler<fallback_clock_opts.spi2_opts.prescaler_bits, SPI2_BASE>();
+	}
+#endif //RCC_APB1ENR_SPI2EN
+#ifdef RCC_APB1ENR_SPI3EN
+	if constexpr (fallback_clock_opts.spi3_opts.used
+		&& fallback_clock_opts.spi3_opts.prescaler_bits != clock_opts.spi3_opts.prescaler_bits)
+	{
+		set_spi_prescaler<fallback_clock_opts.spi3_opts.prescaler_bits, SPI3_BASE>();
+	}
+#endif //RCC_APB1ENR_SPI3EN
+}
 	
 } //namespace mcutl::device::clock
@@ -7,6 +7,7 @@
 #include "mcutl/device/device.h"
 #include "mcutl/interrupt/interrupt.h"
 #include "mcutl/instruction/instruction.h"
+#include "mcutl/memory/bus_cost.h"
 #include "mcutl/memory/volatile_memory.h"
 #include "mcutl/periph/periph.h"
 #include "mcutl/utils/definitions.h"
@@ -461,7 +462,7 @@ void start_transfer(const volatile void* from, volatile void* to,
 	
 	mcutl::instruction::execute<mcutl::device::instruction::type::dmb>();
 	set_dma_register_bits<Channel::dma_index, Channel::channel_number,
-		mcutl::memory::max_bitmask<uint32_t>, &DMA_Channel_TypeDef::CCR>(ccr);
+		mcutl::memory::max_bitmask<uint32_t>, &DMA_Channel_TypeDef::CCR>(ccr | DMA_CCR_EN);
 }
 
 template<typename Channel>
@@ -479,6 +480,73 @@ void wait_transfer() MCUTL_NOEXCEPT
 	mcutl::instruction::execute<mcutl::device::instruction::type::dmb>();
 }
 
+template<typename Channel, typename OptionsLambda>
+constexpr mcutl::memory::bus_cost get_configure_dma_cost(OptionsLambda opts_lambda) noexcept
+{
+	constexpr auto channel_info = get_validated_channel_info<Channel, true>(opts_lambda);
+	constexpr auto opts = opts_lambda();
+	using interrupt_type = mcutl::dma::detail::interrupt_helper_t<
+		Channel::dma_index, Channel::channel_number>;
+	
+	auto cost = mcutl::memory::set_register_bits_cost_v<DMA_CCR_EN_Msk, &DMA_Channel_TypeDef::CCR,
+		channel_reg_mapping<Channel::dma_index, Channel::channel_number>::value>;
+	if constexpr (opts.enable_controller_interrupts_set_count != 0)
+	{
+		if constexpr ((channel_info.ccr
+			& (DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE)) != 0)
+		{
+			cost += mcutl::interrupt::enable_cost_v<mcutl::interrupt::interrupt<interrupt_type,
+				channel_info.interrupt_info.priority, channel_info.interrupt_info.subpriority>>;
+		}
+	}
+	
+	if constexpr (opts.disable_controller_interrupts_set_count != 0)
+	{
+		if constexpr ((channel_info.ccr
+			& (DMA_CCR_TCIE | DMA_CCR_HTIE | DMA_CCR_TEIE)) == 0)
+		{
+			cost += mcutl::interrupt::disable_cost_v<interrupt_type>;
+		}
+	}
+	
+	return cost + mcutl::memory::write_cost;
+}
+
+template<typename Channel, typename OptionsLambda>
+constexpr mcutl::memory::bus_cost get_reconfigure_dma_cost(OptionsLambda opts_lambda) noexcept
+{
+	constexpr auto channel_info = get_validated_channel_info<Channel, false>(opts_lambda);
+	constexpr auto opts = opts_lambda();
+	using interrupt_type = mcutl::dma::detail::interrupt_helper_t<
+		Channel::dma_index, Channel::channel_number>;
+	
+	//Controller interrupt is enabled or disabled depending on the current CCR value,
+	//and both options can not be applied at the same time
+	mcutl::memory::bus_cost interrupt_cost {};
+	if constexpr (opts.enable_controller_interrupts_set_count != 0)
+	{
+		interrupt_cost = mcutl::interrupt::enable_cost_v<mcutl::interrupt::interrupt<interrupt_type,
+			channel_info.interrupt_info.priority, channel_info.interrupt_info.subpriority>>;
+	}
+	if constexpr (opts.disable_controller_interrupts_set_count != 0)
+	{
+		interrupt_cost = mcutl::memory::worst_case(interrupt_cost,
+			mcutl::interrupt::disable_cost_v<interrupt_type>);
+	}
+	
+	auto cost = mcutl::memory::read_cost + mcutl::memory::write_cost + interrupt_cost;
+	if constexpr (channel_info.ccr_mask != 0)
+		cost += mcutl::memory::write_cost;
+	return cost;
+}
+
+//CCR read, CCR write to disable the channel, CPAR, CMAR and CNDTR writes and CCR write to enable the channel
+[[maybe_unused]] constexpr mcutl::memory::bus_cost start_transfer_cost
+	= mcutl::memory::read_cost + mcutl::memory::bus_cost { 0u, 5u, 0u };
+//CCR read and CNDTR polling
+[[maybe_unused]] constexpr mcutl::memory::bus_cost wait_transfer_cost
+	= mcutl::memory::read_cost + mcutl::memory::poll_cost;
+
 template<uint32_t ChannelNumber>
 struct interrupt_flags {};
 
@@ -577,4 +645,45 @@ inline void clear_pending_flags_atomic() MCUTL_NOEXCEPT
 	clear_pending_flags<Channel, Interrupts...>();
 }
 
+//ISR pending flags have the same bit positions as the IFCR flags clearing them
+template<typename Channel, typename... Interrupts>
+[[maybe_unused]] constexpr auto pending_flags_v = (0u | ... | interrupt_info<
+	Channel::channel_number, Interrupts>::pending_flag);
+
+template<typename Channel, typename... Interrupts>
+uint32_t get_pending_flags() MCUTL_NOEXCEPT
+{
+	constexpr auto flags = pending_flags_v<Channel, Interrupts...>;
+	if constexpr (flags == 0)
+	{
+		return 0u;
+	}
+	else
+	{
+		if constexpr (Channel::dma_index == 1)
+		{
+			return mcutl::memory::get_register_bits<flags, &DMA_TypeDef::ISR, DMA1_BASE>();
+		}
+#ifdef DMA2
+		else if constexpr (Channel::dma_index == 2)
+		{
+			return mcutl::memory::get_register_bits<flags, &DMA_TypeDef::ISR, DMA2_BASE>();
+		}
+#endif //DMA2
+		else
+		{
+			static_assert(types::value_always_false<Channel::dma_index>::value,
+				"Unsupported DMA peripheral");
+			return 0u;
+		}
+	}
+}
+
+template<typename Channel>
+size_type get_remaining_transfers() MCUTL_NOEXCEPT
+{
+	return static_cast<size_type>(get_dma_register_bits<Channel::dma_index,
+		Channel::channel_number, &DMA_Channel_TypeDef::CNDTR>());
+}
+
 } //namespace mcutl::device::dma
@@ -2,6 +2,7 @@
 
 #include <array>
 #include <limits>
+#include <stddef.h>
 #include <stdint.h>
 #include <type_traits>
 #include <utility>
@@ -9,6 +10,9 @@
 #include "mcutl/device/gpio/stm32_gpio.h"
 #include "mcutl/gpio/gpio_defs.h"
 #include "mcutl/exti/exti_defs.h"
+#include "mcutl/memory/bus_cost.h"
+#include "mcutl/memory/init_table.h"
+#include "mcutl/memory/shadow_register.h"
 #include "mcutl/memory/volatile_memory.h"
 #include "mcutl/utils/definitions.h"
 #include "mcutl/utils/type_helpers.h"
@@ -504,6 +508,22 @@ struct config_helper<mcutl::gpio::config<PinConfig...>>
 		return config_helper<mcutl::gpio::config<PinConfig...>,
 			available_regs_t>::template get_port_bit_data<PortLetter>();
 	}
+	
+	static constexpr size_t max_init_records = config_helper<mcutl::gpio::config<PinConfig...>,
+		available_regs_t>::max_init_records;
+	
+	static constexpr mcutl::memory::bus_cost get_configure_cost() noexcept
+	{
+		return config_helper<mcutl::gpio::config<PinConfig...>,
+			available_regs_t>::get_configure_cost();
+	}
+	
+	template<typename Builder>
+	static constexpr void add_to_init_table(Builder& builder) noexcept
+	{
+		config_helper<mcutl::gpio::config<PinConfig...>,
+			available_regs_t>::add_to_init_table(builder);
+	}
 };
 
 template<typename... PinConfig, typename... ValidPorts>
@@ -524,11 +544,11 @@ struct config_helper<mcutl::gpio::config<PinConfig...>,
 		constexpr auto data = get_port_bit_data<PortLetter>();
 		constexpr auto port_base = get_port_base<PortLetter>();
 		
-		mcutl::memory::set_register_bits<
+		mcutl::memory::set_shadowed_register_bits<
 			static_cast<uint32_t>(data.cr_changed_bits & (std::numeric_limits<uint32_t>::max)()),
 			static_cast<uint32_t>(data.cr_bit_values & (std::numeric_limits<uint32_t>::max)()),
 			&GPIO_TypeDef::CRL, port_base>();
-		mcutl::memory::set_register_bits<
+		mcutl::memory::set_shadowed_register_bits<
 			static_cast<uint32_t>((data.cr_changed_bits >> 32u) & (std::numeric_limits<uint32_t>::max)()),
 			static_cast<uint32_t>((data.cr_bit_values >> 32u) & (std::numeric_limits<uint32_t>::max)()),
 			&GPIO_TypeDef::CRH, port_base>();
@@ -573,6 +593,81 @@ struct config_helper<mcutl::gpio::config<PinConfig...>,
 		configure_afio();
 		(..., configure<ValidPorts::port_letter>());
 	}
+	
+	template<char PortLetter>
+	static constexpr mcutl::memory::bus_cost get_port_configure_cost() noexcept
+	{
+		constexpr auto data = get_port_bit_data<PortLetter>();
+		constexpr auto port_base = get_port_base<PortLetter>();
+		
+		auto cost = mcutl::memory::set_shadowed_register_bits_cost_v<
+			static_cast<uint32_t>(data.cr_changed_bits & (std::numeric_limits<uint32_t>::max)()),
+			&GPIO_TypeDef::CRL, port_base>
+			+ mcutl::memory::set_shadowed_register_bits_cost_v<
+			static_cast<uint32_t>((data.cr_changed_bits >> 32u) & (std::numeric_limits<uint32_t>::max)()),
+			&GPIO_TypeDef::CRH, port_base>;
+		if constexpr (data.dr_set_bits || data.dr_reset_bits)
+			cost += mcutl::memory::write_cost;
+		return cost;
+	}
+	
+	static constexpr mcutl::memory::bus_cost get_configure_cost() noexcept
+	{
+		constexpr auto data = get_afio_data();
+		return mcutl::memory::set_register_array_bits_cost_v<data.afio_exti_changed_bits[0],
+				&AFIO_TypeDef::EXTICR, 0, AFIO_BASE>
+			+ mcutl::memory::set_register_array_bits_cost_v<data.afio_exti_changed_bits[1],
+				&AFIO_TypeDef::EXTICR, 1, AFIO_BASE>
+			+ mcutl::memory::set_register_array_bits_cost_v<data.afio_exti_changed_bits[2],
+				&AFIO_TypeDef::EXTICR, 2, AFIO_BASE>
+			+ mcutl::memory::set_register_array_bits_cost_v<data.afio_exti_changed_bits[3],
+				&AFIO_TypeDef::EXTICR, 3, AFIO_BASE>
+			+ (mcutl::memory::bus_cost{} + ... + get_port_configure_cost<ValidPorts::port_letter>());
+	}
+	
+	static constexpr size_t max_init_records = 4u + 3u * sizeof...(ValidPorts);
+	
+	template<char PortLetter, typename Builder>
+	static constexpr void add_port_to_init_table(Builder& builder) noexcept
+	{
+		constexpr auto data = get_port_bit_data<PortLetter>();
+		constexpr auto port_base = get_port_base<PortLetter>();
+		constexpr auto crl_changed_bits = static_cast<uint32_t>(
+			data.cr_changed_bits & (std::numeric_limits<uint32_t>::max)());
+		constexpr auto crh_changed_bits = static_cast<uint32_t>(
+			(data.cr_changed_bits >> 32u) & (std::numeric_limits<uint32_t>::max)());
+		static_assert(!crl_changed_bits
+			|| !mcutl::memory::is_register_shadowed_v<&GPIO_TypeDef::CRL, port_base>,
+			"Shadowed registers can not be initialized using init tables");
+		static_assert(!crh_changed_bits
+			|| !mcutl::memory::is_register_shadowed_v<&GPIO_TypeDef::CRH, port_base>,
+			"Shadowed registers can not be initialized using init tables");
+		
+		builder.set_bits(port_base + offsetof(GPIO_TypeDef, CRL), crl_changed_bits,
+			static_cast<uint32_t>(data.cr_bit_values & (std::numeric_limits<uint32_t>::max)()));
+		builder.set_bits(port_base + offsetof(GPIO_TypeDef, CRH), crh_changed_bits,
+			static_cast<uint32_t>((data.cr_bit_values >> 32u) & (std::numeric_limits<uint32_t>::max)()));
+		
+		if (data.dr_set_bits || data.dr_reset_bits)
+		{
+			builder.set_value(port_base + offsetof(GPIO_TypeDef, BSRR),
+				(static_cast<uint32_t>(data.dr_set_bits) << GPIO_BSRR_BS0_Pos)
+					| static_cast<uint32_t>(data.dr_reset_bits) << GPIO_BSRR_BR0_Pos);
+		}
+	}
+	
+	template<typename Builder>
+	static constexpr void add_to_init_table(Builder& builder) noexcept
+	{
+		constexpr auto data = get_afio_data();
+		for (size_t i = 0; i != data.afio_exti_changed_bits.size(); ++i)
+		{
+			builder.set_bits(AFIO_BASE + offsetof(AFIO_TypeDef, EXTICR) + i * sizeof(uint32_t),
+				data.afio_exti_changed_bits[i], data.afio_exti_bit_values[i]);
+		}
+		
+		(..., add_port_to_init_table<ValidPorts::port_letter>(builder));
+	}
 };
 
 template<typename PinConfig>
@@ -596,6 +691,38 @@ struct gpio_peripheral_control<mcutl::gpio::config<PinConfig...>>
 				mcutl::gpio::to_periph<typename PinConfig::pin>>...>();
 		}
 	}
+	
+	static constexpr mcutl::memory::bus_cost get_enable_cost() noexcept
+	{
+		if constexpr ((... || std::is_same_v<
+			typename PinConfig::tag, mcutl::gpio::detail::exti_tag>))
+		{
+			return mcutl::periph::configure_peripheral_cost_v<
+				mcutl::periph::enable<mcutl::periph::afio>,
+				mcutl::periph::enable<mcutl::gpio::to_periph<typename PinConfig::pin>>...>;
+		}
+		else
+		{
+			return mcutl::periph::configure_peripheral_cost_v<mcutl::periph::enable<
+				mcutl::gpio::to_periph<typename PinConfig::pin>>...>;
+		}
+	}
+	
+	static constexpr auto get_init_table_builder() noexcept
+	{
+		if constexpr ((... || std::is_same_v<
+			typename PinConfig::tag, mcutl::gpio::detail::exti_tag>))
+		{
+			return mcutl::periph::get_init_table_builder<
+				mcutl::periph::enable<mcutl::periph::afio>,
+				mcutl::periph::enable<mcutl::gpio::to_periph<typename PinConfig::pin>>...>();
+		}
+		else
+		{
+			return mcutl::periph::get_init_table_builder<mcutl::periph::enable<
+				mcutl::gpio::to_periph<typename PinConfig::pin>>...>();
+		}
+	}
 };
 
 template<bool EnablePeripheralsRequested, typename PinConfig>
@@ -607,6 +734,188 @@ void configure_gpio() MCUTL_NOEXCEPT
 	config_helper<PinConfig>::configure();
 }
 
+template<bool EnablePeripheralsRequested, typename PinConfig>
+constexpr mcutl::memory::bus_cost get_configure_gpio_cost() noexcept
+{
+	auto cost = config_helper<PinConfig>::get_configure_cost();
+	if constexpr (EnablePeripheralsRequested)
+		cost += gpio_peripheral_control<PinConfig>::get_enable_cost();
+	return cost;
+}
+
+template<bool EnablePeripheralsRequested, typename PinConfig>
+constexpr auto get_init_table_builder() noexcept
+{
+	mcutl::memory::init_table_builder<config_helper<PinConfig>::max_init_records
+		+ (EnablePeripheralsRequested
+			? decltype(gpio_peripheral_control<PinConfig>::get_init_table_builder())::capacity
+			: 0u)> builder;
+	if constexpr (EnablePeripheralsRequested)
+		builder.append(gpio_peripheral_control<PinConfig>::get_init_table_builder());
+	
+	config_helper<PinConfig>::add_to_init_table(builder);
+	return builder;
+}
+
+struct register_transition
+{
+	uint32_t changed_bits = 0;
+	uint32_t bit_values = 0;
+};
+
+//Returns the register bits which must be changed to switch from the From configuration
+//to the To configuration. If all register bits are known after the transition,
+//the whole register value is returned, so that it can be written without reading it first.
+constexpr register_transition get_register_transition(uint32_t from_changed_bits, uint32_t from_bit_values,
+	uint32_t to_changed_bits, uint32_t to_bit_values) noexcept
+{
+	const uint32_t changed_bits = to_changed_bits
+		& (~from_changed_bits | (from_bit_values ^ to_bit_values));
+	if (!changed_bits)
+		return {};
+	
+	const uint32_t known_bits = from_changed_bits | to_changed_bits;
+	if (known_bits == (std::numeric_limits<uint32_t>::max)())
+		return { known_bits, (from_bit_values & ~to_changed_bits) | to_bit_values };
+	
+	return { changed_bits, to_bit_values & changed_bits };
+}
+
+struct port_transition
+{
+	register_transition crl;
+	register_transition crh;
+	uint16_t dr_set_bits = 0;
+	uint16_t dr_reset_bits = 0;
+};
+
+template<typename FromConfig, typename ToConfig, typename ValidPorts>
+struct transition_helper {};
+
+template<typename FromConfig, typename ToConfig, typename... ValidPorts>
+struct transition_helper<FromConfig, ToConfig, valid_gpio_list<ValidPorts...>>
+{
+	using from_helper = config_helper<FromConfig, valid_gpio_list<ValidPorts...>>;
+	using to_helper = config_helper<ToConfig, valid_gpio_list<ValidPorts...>>;
+	
+	template<char PortLetter>
+	static constexpr port_transition get_port_transition() noexcept
+	{
+		constexpr auto from = from_helper::template get_port_bit_data<PortLetter>();
+		constexpr auto to = to_helper::template get_port_bit_data<PortLetter>();
+		
+		port_transition result;
+		result.crl = get_register_transition(
+			static_cast<uint32_t>(from.cr_changed_bits & (std::numeric_limits<uint32_t>::max)()),
+			static_cast<uint32_t>(from.cr_bit_values & (std::numeric_limits<uint32_t>::max)()),
+			static_cast<uint32_t>(to.cr_changed_bits & (std::numeric_limits<uint32_t>::max)()),
+			static_cast<uint32_t>(to.cr_bit_values & (std::numeric_limits<uint32_t>::max)()));
+		result.crh = get_register_transition(
+			static_cast<uint32_t>(from.cr_changed_bits >> 32u),
+			static_cast<uint32_t>(from.cr_bit_values >> 32u),
+			static_cast<uint32_t>(to.cr_changed_bits >> 32u),
+			static_cast<uint32_t>(to.cr_bit_values >> 32u));
+		result.dr_set_bits = to.dr_set_bits & ~from.dr_set_bits;
+		result.dr_reset_bits = to.dr_reset_bits & ~from.dr_reset_bits;
+		return result;
+	}
+	
+	static constexpr std::array<register_transition, 4> get_afio_transition() noexcept
+	{
+		constexpr auto from = from_helper::get_afio_data();
+		constexpr auto to = to_helper::get_afio_data();
+		
+		std::array<register_transition, 4> result {};
+		for (size_t i = 0; i != result.size(); ++i)
+		{
+			result[i] = get_register_transition(from.afio_exti_changed_bits[i],
+				from.afio_exti_bit_values[i], to.afio_exti_changed_bits[i], to.afio_exti_bit_values[i]);
+		}
+		return result;
+	}
+	
+	template<char PortLetter>
+	static void transition_port() MCUTL_NOEXCEPT
+	{
+		constexpr auto data = get_port_transition<PortLetter>();
+		constexpr auto port_base = get_port_base<PortLetter>();
+		
+		mcutl::memory::set_shadowed_register_bits<data.crl.changed_bits, data.crl.bit_values,
+			&GPIO_TypeDef::CRL, port_base>();
+		mcutl::memory::set_shadowed_register_bits<data.crh.changed_bits, data.crh.bit_values,
+			&GPIO_TypeDef::CRH, port_base>();
+		
+		if constexpr (data.dr_set_bits || data.dr_reset_bits)
+		{
+			mcutl::memory::set_register_value<
+				(static_cast<uint32_t>(data.dr_set_bits) << GPIO_BSRR_BS0_Pos)
+					| static_cast<uint32_t>(data.dr_reset_bits) << GPIO_BSRR_BR0_Pos,
+				&GPIO_TypeDef::BSRR, port_base>();
+		}
+	}
+	
+	template<size_t... Indices>
+	static void transition_afio(std::index_sequence<Indices...>) MCUTL_NOEXCEPT
+	{
+		constexpr auto data = get_afio_transition();
+		(..., mcutl::memory::set_register_array_bits<data[Indices].changed_bits,
+			data[Indices].bit_values, &AFIO_TypeDef::EXTICR, Indices, AFIO_BASE>());
+	}
+	
+	static void transition() MCUTL_NOEXCEPT
+	{
+		transition_afio(std::make_index_sequence<4>{});
+		(..., transition_port<ValidPorts::port_letter>());
+	}
+	
+	template<char PortLetter>
+	static constexpr mcutl::memory::bus_cost get_port_transition_cost() noexcept
+	{
+		constexpr auto data = get_port_transition<PortLetter>();
+		constexpr auto port_base = get_port_base<PortLetter>();
+		
+		auto cost = mcutl::memory::set_shadowed_register_bits_cost_v<data.crl.changed_bits,
+				&GPIO_TypeDef::CRL, port_base>
+			+ mcutl::memory::set_shadowed_register_bits_cost_v<data.crh.changed_bits,
+				&GPIO_TypeDef::CRH, port_base>;
+		if constexpr (data.dr_set_bits || data.dr_reset_bits)
+			cost += mcutl::memory::write_cost;
+		return cost;
+	}
+	
+	template<size_t... Indices>
+	static constexpr mcutl::memory::bus_cost get_afio_transition_cost(std::index_sequence<Indices...>) noexcept
+	{
+		constexpr auto data = get_afio_transition();
+		return (mcutl::memory::bus_cost{} + ... + mcutl::memory::set_register_array_bits_cost_v<
+			data[Indices].changed_bits, &AFIO_TypeDef::EXTICR, Indices, AFIO_BASE>);
+	}
+	
+	static constexpr mcutl::memory::bus_cost get_transition_cost() noexcept
+	{
+		return get_afio_transition_cost(std::make_index_sequence<4>{})
+			+ (mcutl::memory::bus_cost{} + ... + get_port_transition_cost<ValidPorts::port_letter>());
+	}
+};
+
+template<bool EnablePeripheralsRequested, typename FromConfig, typename ToConfig>
+void transition() MCUTL_NOEXCEPT
+{
+	if constexpr (EnablePeripheralsRequested)
+		gpio_peripheral_control<ToConfig>::enable();
+	
+	transition_helper<FromConfig, ToConfig, available_regs_t>::transition();
+}
+
+template<bool EnablePeripheralsRequested, typename FromConfig, typename ToConfig>
+constexpr mcutl::memory::bus_cost get_transition_cost() noexcept
+{
+	auto cost = transition_helper<FromConfig, ToConfig, available_regs_t>::get_transition_cost();
+	if constexpr (EnablePeripheralsRequested)
+		cost += gpio_peripheral_control<ToConfig>::get_enable_cost();
+	return cost;
+}
+
 template<bool NegateBits, typename... Pins>
 auto get_input_values_mask() MCUTL_NOEXCEPT
 {
@@ -631,6 +940,209 @@ auto get_output_values_mask() MCUTL_NOEXCEPT
 		return mcutl::memory::get_register_bits<pin_bit_mask, &GPIO_TypeDef::ODR, port_base>();
 }
 
+template<char PortLetter>
+const volatile void* get_input_values_register() MCUTL_NOEXCEPT
+{
+	return &mcutl::memory::volatile_memory<GPIO_TypeDef, get_port_base<PortLetter>()>()->IDR;
+}
+
+template<typename Pins, typename Indices>
+struct group_write_helper {};
+
+template<typename... Pins, size_t... Indices>
+struct group_write_helper<types::list<Pins...>, std::index_sequence<Indices...>>
+{
+	template<char PortLetter>
+	static constexpr uint32_t get_port_pin_mask() noexcept
+	{
+		return (0u | ... | (Pins::port_letter == PortLetter ? (1u << Pins::pin_number) : 0u));
+	}
+	
+	template<char PortLetter>
+	static constexpr int32_t get_bit_offset() noexcept
+	{
+		int32_t offset = 0;
+		(..., (Pins::port_letter == PortLetter
+			? (offset = static_cast<int32_t>(Pins::pin_number) - static_cast<int32_t>(Indices))
+			: offset));
+		return offset;
+	}
+	
+	//Returns true if all group pins of the port are placed in the same order
+	//and with the same gaps as the corresponding value bits
+	template<char PortLetter>
+	static constexpr bool has_same_bit_offset() noexcept
+	{
+		constexpr int32_t offset = get_bit_offset<PortLetter>();
+		return (true && ... && (Pins::port_letter != PortLetter
+			|| static_cast<int32_t>(Pins::pin_number) - static_cast<int32_t>(Indices) == offset));
+	}
+	
+	template<char PortLetter>
+	static constexpr uint32_t get_port_set_bits(uint32_t value) noexcept
+	{
+		constexpr auto pin_mask = get_port_pin_mask<PortLetter>();
+		if constexpr (has_same_bit_offset<PortLetter>())
+		{
+			constexpr auto offset = get_bit_offset<PortLetter>();
+			if constexpr (offset >= 0)
+				return (value << offset) & pin_mask;
+			else
+				return (value >> -offset) & pin_mask;
+		}
+		else
+		{
+			return (0u | ... | (Pins::port_letter == PortLetter
+				? ((value >> Indices) & 1u) << Pins::pin_number : 0u));
+		}
+	}
+	
+	template<char PortLetter>
+	static void write_port(uint32_t value) MCUTL_NOEXCEPT
+	{
+		constexpr auto pin_mask = get_port_pin_mask<PortLetter>();
+		if constexpr (pin_mask != 0)
+		{
+			//BSx bits have priority over BRx bits, so all group pins of the port
+			//are reset except the ones being set
+			mcutl::memory::set_register_value<&GPIO_TypeDef::BSRR, get_port_base<PortLetter>()>(
+				(pin_mask << GPIO_BSRR_BR0_Pos) | (get_port_set_bits<PortLetter>(value) << GPIO_BSRR_BS0_Pos));
+		}
+	}
+	
+	template<typename... ValidPorts>
+	static void write(uint32_t value, valid_gpio_list<ValidPorts...>) MCUTL_NOEXCEPT
+	{
+		(..., write_port<ValidPorts::port_letter>(value));
+	}
+	
+	template<typename... ValidPorts>
+	static constexpr mcutl::memory::bus_cost get_write_cost(valid_gpio_list<ValidPorts...>) noexcept
+	{
+		return (mcutl::memory::bus_cost{} + ... + (get_port_pin_mask<ValidPorts::port_letter>()
+			? mcutl::memory::write_cost : mcutl::memory::bus_cost{}));
+	}
+};
+
+template<typename... Pins>
+using group_write_helper_t = group_write_helper<types::list<Pins...>,
+	std::index_sequence_for<Pins...>>;
+
+using port_write_word_type = uint32_t;
+
+//Returns the BSRR word, which writes the group value to the group pins of a single port
+template<typename... Pins>
+constexpr port_write_word_type get_port_write_word(uint32_t value) noexcept
+{
+	constexpr auto port_letter = pin_port_letter_helper<Pins...>::get_first_pin_port_letter();
+	constexpr auto pin_mask = get_pin_bit_mask<Pins...>();
+	return (pin_mask << GPIO_BSRR_BR0_Pos) | (group_write_helper_t<Pins...>::template
+		get_port_set_bits<port_letter>(value) << GPIO_BSRR_BS0_Pos);
+}
+
+template<char PortLetter>
+volatile void* get_port_write_register() MCUTL_NOEXCEPT
+{
+	return &mcutl::memory::volatile_memory<GPIO_TypeDef, get_port_base<PortLetter>()>()->BSRR;
+}
+
+//Writes the bus value using per-port lookup tables, which map each ChunkBits-wide
+//part of the value to the BSRR set bits of the port. Ports with pins following
+//the value bit order do not need the tables and are written using a shift.
+template<uint32_t ChunkBits, typename Pins, typename Indices>
+struct parallel_bus_helper {};
+
+template<uint32_t ChunkBits, typename... Pins, size_t... Indices>
+struct parallel_bus_helper<ChunkBits, types::list<Pins...>, std::index_sequence<Indices...>>
+	: group_write_helper<types::list<Pins...>, std::index_sequence<Indices...>>
+{
+	using base = group_write_helper<types::list<Pins...>, std::index_sequence<Indices...>>;
+	static constexpr size_t chunk_count = (sizeof...(Pins) + ChunkBits - 1u) / ChunkBits;
+	static constexpr uint32_t chunk_mask = (1u << ChunkBits) - 1u;
+	
+	using port_table_t = std::array<std::array<uint16_t, chunk_mask + 1u>, chunk_count>;
+	
+	template<char PortLetter>
+	static constexpr bool chunk_has_port_pins(size_t chunk) noexcept
+	{
+		return (false || ... || (Pins::port_letter == PortLetter && Indices / ChunkBits == chunk));
+	}
+	
+	template<char PortLetter>
+	static constexpr port_table_t make_port_table() noexcept
+	{
+		port_table_t table {};
+		for (size_t chunk = 0; chunk != chunk_count; ++chunk)
+		{
+			for (uint32_t value = 0; value <= chunk_mask; ++value)
+			{
+				table[chunk][value] = static_cast<uint16_t>(base::template get_port_set_bits<PortLetter>(
+					value << (chunk * ChunkBits)));
+			}
+		}
+		return table;
+	}
+	
+	template<char PortLetter>
+	static constexpr port_table_t port_table = make_port_table<PortLetter>();
+	
+	template<char PortLetter, size_t Chunk>
+	static uint32_t get_chunk_set_bits(uint32_t value) noexcept
+	{
+		if constexpr (chunk_has_port_pins<PortLetter>(Chunk))
+			return port_table<PortLetter>[Chunk][(value >> (Chunk * ChunkBits)) & chunk_mask];
+		else
+			return 0u;
+	}
+	
+	template<char PortLetter, size_t... Chunks>
+	static uint32_t get_port_set_bits(uint32_t value, std::index_sequence<Chunks...>) noexcept
+	{
+		return (0u | ... | get_chunk_set_bits<PortLetter, Chunks>(value));
+	}
+	
+	template<char PortLetter>
+	static void write_port(uint32_t value) MCUTL_NOEXCEPT
+	{
+		constexpr auto pin_mask = base::template get_port_pin_mask<PortLetter>();
+		if constexpr (pin_mask != 0 && base::template has_same_bit_offset<PortLetter>())
+		{
+			base::template write_port<PortLetter>(value);
+		}
+		else if constexpr (pin_mask != 0)
+		{
+			mcutl::memory::set_register_value<&GPIO_TypeDef::BSRR, get_port_base<PortLetter>()>(
+				(pin_mask << GPIO_BSRR_BR0_Pos) | (get_port_set_bits<PortLetter>(
+					value, std::make_index_sequence<chunk_count>{}) << GPIO_BSRR_BS0_Pos));
+		}
+	}
+	
+	template<typename... ValidPorts>
+	static void write(uint32_t value, valid_gpio_list<ValidPorts...>) MCUTL_NOEXCEPT
+	{
+		(..., write_port<ValidPorts::port_letter>(value));
+	}
+};
+
+template<uint32_t ChunkBits, typename... Pins>
+void write_parallel_bus(uint32_t value) MCUTL_NOEXCEPT
+{
+	parallel_bus_helper<ChunkBits, types::list<Pins...>,
+		std::index_sequence_for<Pins...>>::write(value, available_regs_t{});
+}
+
+template<typename... Pins>
+void write_group(uint32_t value) MCUTL_NOEXCEPT
+{
+	group_write_helper_t<Pins...>::write(value, available_regs_t{});
+}
+
+template<typename... Pins>
+constexpr mcutl::memory::bus_cost get_write_group_cost() noexcept
+{
+	return group_write_helper_t<Pins...>::get_write_cost(available_regs_t{});
+}
+
 template<typename Pin>
 bool is_output() MCUTL_NOEXCEPT
 {
@@ -5,6 +5,7 @@
 #include "mcutl/device/device.h"
 #include "mcutl/interrupt/interrupt_defs.h"
 #include "mcutl/instruction/instruction.h"
+#include "mcutl/memory/bus_cost.h"
 #include "mcutl/memory/volatile_memory.h"
 #include "mcutl/utils/math.h"
 
@@ -340,4 +341,33 @@ inline void clear_pending_atomic() noexcept
 	clear_pending<Interrupt>();
 }
 
+template<typename Interrupt>
+constexpr mcutl::memory::bus_cost get_enable_cost() noexcept
+{
+	return mcutl::memory::set_register_array_bits_cost_v<mcutl::memory::max_bitmask<uint32_t>,
+		&NVIC_Type::ISER, (Interrupt::irqn >> 5u), NVIC_BASE>;
+}
+
+template<typename Interrupt>
+constexpr mcutl::memory::bus_cost get_disable_cost() noexcept
+{
+	return mcutl::memory::set_register_array_bits_cost_v<mcutl::memory::max_bitmask<uint32_t>,
+		&NVIC_Type::ICER, (Interrupt::irqn >> 5u), NVIC_BASE>;
+}
+
+template<typename Interrupt>
+constexpr mcutl::memory::bus_cost get_set_priority_cost() noexcept
+{
+	if constexpr (Interrupt::irqn >= 0)
+	{
+		return mcutl::memory::set_register_array_bits_cost_v<mcutl::memory::max_bitmask<uint8_t>,
+			&NVIC_Type::IP, Interrupt::irqn, NVIC_BASE>;
+	}
+	else
+	{
+		return mcutl::memory::set_register_array_bits_cost_v<mcutl::memory::max_bitmask<uint8_t>,
+			&SCB_Type::SHP, (static_cast<uint32_t>(Interrupt::irqn) & 0xful) - 4ul, SCB_BASE>;
+	}
+}
+
 } //namespace mcutl::device::interrupt
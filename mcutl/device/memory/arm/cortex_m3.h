@@ -359,4 +359,28 @@ inline void set_register_array_bits(RegType RegStruct::*reg_ptr) MCUTL_NOEXCEPT
 	}
 }
 
+template<auto BitMask, auto Reg, uintptr_t RegStructBase>
+constexpr std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>, bool>
+	set_register_bits_needs_read() noexcept
+{
+	using reg_type = std::remove_cv_t<types::type_of_member_pointer_t<Reg>>;
+	constexpr auto unsigned_bitmask = static_cast<std::make_unsigned_t<reg_type>>(BitMask);
+	if constexpr (bit_band_available<unsigned_bitmask, decltype(Reg), RegStructBase>())
+		return false;
+	else
+		return common::set_register_bits_needs_read<BitMask, Reg, RegStructBase>();
+}
+
+template<auto BitMask, auto Reg, size_t RegArrIndex, uintptr_t RegStructBase>
+constexpr std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>, bool>
+	set_register_array_bits_needs_read() noexcept
+{
+	using reg_type = std::remove_cv_t<std::remove_all_extents_t<types::type_of_member_pointer_t<Reg>>>;
+	constexpr auto unsigned_bitmask = static_cast<std::make_unsigned_t<reg_type>>(BitMask);
+	if constexpr (bit_band_available<unsigned_bitmask, decltype(Reg), RegArrIndex, RegStructBase>())
+		return false;
+	else
+		return common::set_register_array_bits_needs_read<BitMask, Reg, RegArrIndex, RegStructBase>();
+}
+
 } //namespace mcutl::device::memory
@@ -11,12 +11,15 @@ using mcutl::device::memory::common::max_bitmask;
 using mcutl::device::memory::common::to_address;
 using mcutl::device::memory::common::to_bytes;
 using mcutl::device::memory::common::volatile_memory;
+using mcutl::device::memory::common::pinned_volatile_memory;
 using mcutl::device::memory::common::get_register_bits;
 using mcutl::device::memory::common::get_register_array_bits;
 
 #ifndef MCUTL_CORTEX_M3
 using mcutl::device::memory::common::set_register_bits;
 using mcutl::device::memory::common::set_register_array_bits;
+using mcutl::device::memory::common::set_register_bits_needs_read;
+using mcutl::device::memory::common::set_register_array_bits_needs_read;
 #endif //MCUTL_CORTEX_M3
 } //namespace mcutl::device::memory
 
@@ -21,6 +21,18 @@ template<typename Type, typename Address>
 	return reinterpret_cast<volatile Type*>(address);
 }
 
+template<typename Type, auto Address>
+[[nodiscard]] inline volatile Type* pinned_volatile_memory() noexcept
+{
+	auto ptr = volatile_memory<Type, Address>();
+#ifdef __GNUC__
+	//Hide the constant address from the optimizer, so that it is loaded
+	//to a register once and is not rematerialized before each access
+	__asm__("" : "+r"(ptr));
+#endif //__GNUC__
+	return ptr;
+}
+
 template<typename Pointer>
 [[nodiscard]] inline uintptr_t to_address(volatile Pointer* pointer) noexcept
 {
@@ -429,4 +441,23 @@ template<auto BitMask, size_t RegArrIndex, typename RegType, typename RegStruct>
 	}
 }
 
+//Returns true if setting the masked bits requires a read-modify-write sequence
+template<auto BitMask, auto Reg, uintptr_t RegStructBase>
+constexpr std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>, bool>
+	set_register_bits_needs_read() noexcept
+{
+	using reg_type = std::remove_cv_t<types::type_of_member_pointer_t<Reg>>;
+	constexpr auto unsigned_bitmask = static_cast<std::make_unsigned_t<reg_type>>(BitMask);
+	return unsigned_bitmask && unsigned_bitmask != max_bitmask<decltype(unsigned_bitmask)>;
+}
+
+template<auto BitMask, auto Reg, size_t RegArrIndex, uintptr_t RegStructBase>
+constexpr std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>, bool>
+	set_register_array_bits_needs_read() noexcept
+{
+	using reg_type = std::remove_cv_t<std::remove_all_extents_t<types::type_of_member_pointer_t<Reg>>>;
+	constexpr auto unsigned_bitmask = static_cast<std::make_unsigned_t<reg_type>>(BitMask);
+	return unsigned_bitmask && unsigned_bitmask != max_bitmask<decltype(unsigned_bitmask)>;
+}
+
 } //namespace mcutl::device::memory::common
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <stddef.h>
 #include <stdint.h>
 
 #include "mcutl/device/device.h"
+#include "mcutl/memory/bus_cost.h"
+#include "mcutl/memory/init_table.h"
+#include "mcutl/memory/shadow_register.h"
 #include "mcutl/memory/volatile_memory.h"
 #include "mcutl/periph/periph_defs.h"
 #include "mcutl/utils/definitions.h"
@@ -134,19 +138,19 @@ void configure_peripheral(PeripheralConfigLambda config_lambda) MCUTL_NOEXCEPT
 	static constexpr auto config = config_lambda();
 	if constexpr (!!config.ahb_enr_changed)
 	{
-		mcutl::memory::set_register_bits<config.ahb_enr_changed, config.ahb_enr,
+		mcutl::memory::set_shadowed_register_bits<config.ahb_enr_changed, config.ahb_enr,
 			&RCC_TypeDef::AHBENR, RCC_BASE>();
 		[[maybe_unused]] auto value = mcutl::memory::get_register_bits<&RCC_TypeDef::AHBENR, RCC_BASE>();
 	}
 	if constexpr (!!config.apb1_enr_changed)
 	{
-		mcutl::memory::set_register_bits<config.apb1_enr_changed, config.apb1_enr,
+		mcutl::memory::set_shadowed_register_bits<config.apb1_enr_changed, config.apb1_enr,
 			&RCC_TypeDef::APB1ENR, RCC_BASE>();
 		[[maybe_unused]] auto value = mcutl::memory::get_register_bits<&RCC_TypeDef::APB1ENR, RCC_BASE>();
 	}
 	if constexpr (!!config.apb2_enr_changed)
 	{
-		mcutl::memory::set_register_bits<config.apb2_enr_changed, config.apb2_enr,
+		mcutl::memory::set_shadowed_register_bits<config.apb2_enr_changed, config.apb2_enr,
 			&RCC_TypeDef::APB2ENR, RCC_BASE>();
 		[[maybe_unused]] auto value = mcutl::memory::get_register_bits<&RCC_TypeDef::APB2ENR, RCC_BASE>();
 	}
@@ -156,6 +160,77 @@ void configure_peripheral(PeripheralConfigLambda config_lambda) MCUTL_NOEXCEPT
 		&RCC_TypeDef::APB2RSTR, RCC_BASE>();
 }
 
+template<typename PeripheralConfigLambda>
+constexpr mcutl::memory::bus_cost get_configure_peripheral_cost(
+	PeripheralConfigLambda config_lambda) noexcept
+{
+	constexpr auto config = config_lambda();
+	mcutl::memory::bus_cost cost {};
+	if constexpr (!!config.ahb_enr_changed)
+	{
+		cost += mcutl::memory::set_shadowed_register_bits_cost_v<config.ahb_enr_changed,
+			&RCC_TypeDef::AHBENR, RCC_BASE>;
+		cost += mcutl::memory::read_cost;
+	}
+	if constexpr (!!config.apb1_enr_changed)
+	{
+		cost += mcutl::memory::set_shadowed_register_bits_cost_v<config.apb1_enr_changed,
+			&RCC_TypeDef::APB1ENR, RCC_BASE>;
+		cost += mcutl::memory::read_cost;
+	}
+	if constexpr (!!config.apb2_enr_changed)
+	{
+		cost += mcutl::memory::set_shadowed_register_bits_cost_v<config.apb2_enr_changed,
+			&RCC_TypeDef::APB2ENR, RCC_BASE>;
+		cost += mcutl::memory::read_cost;
+	}
+	cost += mcutl::memory::set_register_bits_cost_v<config.apb1_rst_changed,
+		&RCC_TypeDef::APB1RSTR, RCC_BASE>;
+	cost += mcutl::memory::set_register_bits_cost_v<config.apb2_rst_changed,
+		&RCC_TypeDef::APB2RSTR, RCC_BASE>;
+	return cost;
+}
+
+template<typename PeripheralConfigLambda>
+constexpr auto get_init_table_builder(PeripheralConfigLambda config_lambda) noexcept
+{
+	constexpr auto config = config_lambda();
+	static_assert(!config.ahb_enr_changed
+		|| !mcutl::memory::is_register_shadowed_v<&RCC_TypeDef::AHBENR, RCC_BASE>,
+		"Shadowed registers can not be initialized using init tables");
+	static_assert(!config.apb1_enr_changed
+		|| !mcutl::memory::is_register_shadowed_v<&RCC_TypeDef::APB1ENR, RCC_BASE>,
+		"Shadowed registers can not be initialized using init tables");
+	static_assert(!config.apb2_enr_changed
+		|| !mcutl::memory::is_register_shadowed_v<&RCC_TypeDef::APB2ENR, RCC_BASE>,
+		"Shadowed registers can not be initialized using init tables");
+	
+	mcutl::memory::init_table_builder<8> builder;
+	if (config.ahb_enr_changed)
+	{
+		builder.set_bits(RCC_BASE + offsetof(RCC_TypeDef, AHBENR),
+			config.ahb_enr_changed, config.ahb_enr);
+		builder.read(RCC_BASE + offsetof(RCC_TypeDef, AHBENR));
+	}
+	if (config.apb1_enr_changed)
+	{
+		builder.set_bits(RCC_BASE + offsetof(RCC_TypeDef, APB1ENR),
+			config.apb1_enr_changed, config.apb1_enr);
+		builder.read(RCC_BASE + offsetof(RCC_TypeDef, APB1ENR));
+	}
+	if (config.apb2_enr_changed)
+	{
+		builder.set_bits(RCC_BASE + offsetof(RCC_TypeDef, APB2ENR),
+			config.apb2_enr_changed, config.apb2_enr);
+		builder.read(RCC_BASE + offsetof(RCC_TypeDef, APB2ENR));
+	}
+	builder.set_bits(RCC_BASE + offsetof(RCC_TypeDef, APB1RSTR),
+		config.apb1_rst_changed, config.apb1_rst);
+	builder.set_bits(RCC_BASE + offsetof(RCC_TypeDef, APB2RSTR),
+		config.apb2_rst_changed, config.apb2_rst);
+	return builder;
+}
+
 template<uint32_t EnableDisableBit, uint32_t ResetBit>
 struct ahb_peripheral_configurer_base
 {
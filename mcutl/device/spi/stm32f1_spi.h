@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <stdint.h>
 #include <type_traits>
+#include <utility>
 
 #include "mcutl/clock/clock.h"
 #include "mcutl/dma/dma.h"
@@ -486,12 +487,11 @@ protected:
 		if constexpr (!!options.clear_error_flags_set_count)
 			clear_error_flags();
 		
-		mcutl::memory::set_register_bits<SPI_CR1_SPE_Msk, ~SPI_CR1_SPE,
-			&SPI_TypeDef::CR1, Derived::spi_traits::base>();
+		mcutl::memory::register_block<SPI_TypeDef, Derived::spi_traits::base> spi;
+		mcutl::memory::set_register_bits<SPI_CR1_SPE_Msk, ~SPI_CR1_SPE, &SPI_TypeDef::CR1>(spi);
 		mcutl::memory::set_register_bits<0xffffffffu & ~SPI_CR1_BR_Msk,
-			options.spi_cr1, &SPI_TypeDef::CR1, Derived::spi_traits::base>();
-		mcutl::memory::set_register_value<options.spi_cr2,
-			&SPI_TypeDef::CR2, Derived::spi_traits::base>();
+			options.spi_cr1, &SPI_TypeDef::CR1>(spi);
+		mcutl::memory::set_register_value<options.spi_cr2, &SPI_TypeDef::CR2>(spi);
 		
 		if constexpr (!!options.enable_controller_interrupts_set_count)
 		{
@@ -549,15 +549,15 @@ protected:
 	
 	static void clear_error_flags() MCUTL_NOEXCEPT
 	{
-		auto cr1 = mcutl::memory::get_register_bits<&SPI_TypeDef::CR1, Derived::spi_traits::base>();
+		mcutl::memory::register_block<SPI_TypeDef, Derived::spi_traits::base> spi;
+		auto cr1 = mcutl::memory::get_register_bits<&SPI_TypeDef::CR1>(spi);
 		//Clear OVR flag and UDR flag
-		[[maybe_unused]] auto temp = mcutl::memory::get_register_bits<&SPI_TypeDef::DR,
-			Derived::spi_type::base>();
-		temp = mcutl::memory::get_register_bits<&SPI_TypeDef::SR, Derived::spi_traits::base>();
+		[[maybe_unused]] auto temp = mcutl::memory::get_register_bits<&SPI_TypeDef::DR>(spi);
+		temp = mcutl::memory::get_register_bits<&SPI_TypeDef::SR>(spi);
 		//Clear CRCERR flag
-		mcutl::memory::set_register_value<0u, &SPI_TypeDef::SR, Derived::spi_traits::base>();
+		mcutl::memory::set_register_value<0u, &SPI_TypeDef::SR>(spi);
 		//Previous write to SR and the following write to CR1 will clear MODF, too
-		mcutl::memory::set_register_value<&SPI_TypeDef::CR1, Derived::spi_traits::base>(cr1);
+		mcutl::memory::set_register_value<&SPI_TypeDef::CR1>(spi, cr1);
 	}
 };
 
@@ -704,4 +704,74 @@ void change_prescaler() MCUTL_NOEXCEPT
 	device::clock::set_spi_prescaler<new_prescaler_bits, detail::spi_traits<Spi>::base>();
 }
 
+template<typename Spi, typename ProfileSet, typename FrequencyOption>
+class profile_prescaler
+{
+public:
+	using profile_set_type = ProfileSet;
+	
+	[[nodiscard]] static constexpr uint64_t get_input_frequency(size_t profile) noexcept
+	{
+		return input_frequencies_[profile];
+	}
+	
+	[[nodiscard]] static constexpr uint32_t get_prescaler(size_t profile) noexcept
+	{
+		return prescalers_[profile];
+	}
+	
+	static void retime(size_t profile) MCUTL_NOEXCEPT
+	{
+		mcutl::memory::set_register_bits<SPI_CR1_BR_Msk, &SPI_TypeDef::CR1,
+			detail::spi_traits<Spi>::base>(prescaler_bits_[profile]);
+	}
+	
+private:
+	template<size_t Profile>
+	static constexpr uint64_t get_profile_input_frequency() noexcept
+	{
+		return clock::get_clock_info<typename ProfileSet::template profile_t<Profile>,
+			detail::spi_traits<Spi>::clock_id>().get_unscaled_frequency();
+	}
+	
+	template<size_t Profile>
+	static constexpr uint32_t get_profile_prescaler() noexcept
+	{
+		constexpr auto prescaler = device::spi::spi_prescaler_selector<FrequencyOption>
+			::select(get_profile_input_frequency<Profile>());
+		static_assert(prescaler != 0,
+			"Unable to select prescaler with specified frequency requirements for one of clock profiles");
+		return prescaler;
+	}
+	
+	template<size_t... Profiles>
+	static constexpr auto get_input_frequencies(std::index_sequence<Profiles...>) noexcept
+	{
+		return std::array<uint64_t, ProfileSet::profile_count> {
+			get_profile_input_frequency<Profiles>()... };
+	}
+	
+	template<size_t... Profiles>
+	static constexpr auto get_prescalers(std::index_sequence<Profiles...>) noexcept
+	{
+		return std::array<uint32_t, ProfileSet::profile_count> {
+			get_profile_prescaler<Profiles>()... };
+	}
+	
+	template<size_t... Profiles>
+	static constexpr auto get_prescaler_bits(std::index_sequence<Profiles...>) noexcept
+	{
+		return std::array<uint32_t, ProfileSet::profile_count> {
+			device::clock::get_spi_prescaler_bits<get_profile_prescaler<Profiles>()>().prescaler_bits... };
+	}
+	
+private:
+	static constexpr auto input_frequencies_ = get_input_frequencies(
+		std::make_index_sequence<ProfileSet::profile_count>());
+	static constexpr auto prescalers_ = get_prescalers(
+		std::make_index_sequence<ProfileSet::profile_count>());
+	static constexpr auto prescaler_bits_ = get_prescaler_bits(
+		std::make_index_sequence<ProfileSet::profile_count>());
+};
+
 } //namespace mcutl::spi
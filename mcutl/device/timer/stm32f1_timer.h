@@ -7,6 +7,7 @@
 
 #include "mcutl/clock/clock.h"
 #include "mcutl/device/device.h"
+#include "mcutl/dma/dma.h"
 #include "mcutl/interrupt/interrupt.h"
 #include "mcutl/memory/volatile_memory.h"
 #include "mcutl/periph/periph.h"
@@ -31,6 +32,9 @@ struct disable_update {};
 
 struct trigger_registers_update {};
 
+template<bool Enable>
+struct update_dma_request {};
+
 namespace master_mode
 {
 
@@ -50,6 +54,13 @@ using update = overflow;
 namespace detail
 {
 
+template<typename Timer>
+struct dma_channel_helper
+{
+	static_assert(types::always_false<Timer>::value,
+		"Selected timer update event is not mapped to any DMA channel");
+};
+
 struct prescaler_traits : prescaler_traits_base<types::limits<1, 65536>> {};
 
 using reload_limits = types::limits<2, 65536>;
@@ -85,6 +96,11 @@ using timer2 = detail::timer_base<2, uint16_t, 0xffffu, mcutl::periph::timer2,
 namespace detail
 {
 
+template<> struct dma_channel_helper<timer2>
+{
+	using update = dma::dma1<2>;
+};
+
 template<>
 struct interrupt_type_helper<timer2, interrupt::update> : types::identity<mcutl::interrupt::type::tim2> {};
 
@@ -98,6 +114,11 @@ using timer3 = detail::timer_base<3, uint16_t, 0xffffu, mcutl::periph::timer3,
 namespace detail
 {
 
+template<> struct dma_channel_helper<timer3>
+{
+	using update = dma::dma1<3>;
+};
+
 template<>
 struct interrupt_type_helper<timer3, interrupt::update> : types::identity<mcutl::interrupt::type::tim3> {};
 
@@ -111,6 +132,11 @@ using timer4 = detail::timer_base<4, uint16_t, 0xffffu, mcutl::periph::timer4,
 namespace detail
 {
 
+template<> struct dma_channel_helper<timer4>
+{
+	using update = dma::dma1<7>;
+};
+
 template<>
 struct interrupt_type_helper<timer4, interrupt::update> : types::identity<mcutl::interrupt::type::tim4> {};
 
@@ -124,6 +150,13 @@ using timer5 = detail::timer_base<5, uint16_t, 0xffffu, mcutl::periph::timer5,
 namespace detail
 {
 
+#ifdef DMA2
+template<> struct dma_channel_helper<timer5>
+{
+	using update = dma::dma2<2>;
+};
+#endif //DMA2
+
 template<>
 struct interrupt_type_helper<timer5, interrupt::update> : types::identity<mcutl::interrupt::type::tim5> {};
 
@@ -137,6 +170,13 @@ using timer6 = detail::timer_base<6, uint16_t, 0xffffu, mcutl::periph::timer6,
 namespace detail
 {
 
+#ifdef DMA2
+template<> struct dma_channel_helper<timer6>
+{
+	using update = dma::dma2<3>;
+};
+#endif //DMA2
+
 template<>
 struct interrupt_type_helper<timer6, interrupt::update> : types::identity<mcutl::interrupt::type::tim6> {};
 
@@ -150,6 +190,13 @@ using timer7 = detail::timer_base<7, uint16_t, 0xffffu, mcutl::periph::timer7,
 namespace detail
 {
 
+#ifdef DMA2
+template<> struct dma_channel_helper<timer7>
+{
+	using update = dma::dma2<4>;
+};
+#endif //DMA2
+
 template<>
 struct interrupt_type_helper<timer7, interrupt::update> : types::identity<mcutl::interrupt::type::tim7> {};
 
@@ -202,6 +249,11 @@ using timer1 = detail::timer_base<1, uint16_t, 0xffffu, mcutl::periph::timer1,
 namespace detail
 {
 
+template<> struct dma_channel_helper<timer1>
+{
+	using update = dma::dma1<5>;
+};
+
 #if defined(STM32F103xG) || defined(STM32F101xG) //XL-density
 template<>
 struct interrupt_type_helper<timer1, interrupt::update> : types::identity<mcutl::interrupt::type::tim1_up_tim10> {};
@@ -220,6 +272,13 @@ using timer8 = detail::timer_base<8, uint16_t, 0xffffu, mcutl::periph::timer8,
 namespace detail
 {
 
+#ifdef DMA2
+template<> struct dma_channel_helper<timer8>
+{
+	using update = dma::dma2<1>;
+};
+#endif //DMA2
+
 #if defined(STM32F103xG) || defined(STM32F101xG) //XL-density
 template<>
 struct interrupt_type_helper<timer8, interrupt::update> : types::identity<mcutl::interrupt::type::tim8_up_tim13> {};
@@ -270,6 +329,9 @@ struct interrupt_type_helper<timer11, interrupt::update> : types::identity<mcutl
 } //namespace detail
 #endif //RCC_APB2ENR_TIM11EN
 
+template<typename Timer>
+using update_dma_channel = typename detail::dma_channel_helper<Timer>::update;
+
 } //namespace mcutl::timer
 
 namespace mcutl::device::timer
@@ -300,11 +362,13 @@ struct options : mcutl::timer::detail::options
 		= update_request_source::overflow_ug_bit_slave_controller;
 	bool disable_update = false;
 	master_mode::value master = master_mode::none;
+	bool update_dma_request = false;
 	
 	uint32_t update_request_source_set_count = 0;
 	uint32_t disable_update_set_count = 0;
 	uint32_t trigger_registers_update_set_count = 0;
 	uint32_t master_set_count = 0;
+	uint32_t update_dma_request_set_count = 0;
 };
 
 } // namespace mcutl::device::timer
@@ -334,6 +398,12 @@ struct options_parser<Timer, trigger_registers_update>
 	: opts::base_option_parser<0, nullptr,
 	&device::timer::options::trigger_registers_update_set_count> {};
 
+template<typename Timer, bool Enable>
+struct options_parser<Timer, update_dma_request<Enable>>
+	: opts::base_option_parser<Enable,
+	&device::timer::options::update_dma_request,
+	&device::timer::options::update_dma_request_set_count> {};
+
 template<typename Timer>
 struct options_parser<Timer, master_mode::none>
 	: opts::base_option_parser<device::timer::master_mode::none,
@@ -441,6 +511,27 @@ void set_timer_count(uint16_t value) MCUTL_NOEXCEPT
 	mcutl::memory::set_register_value<&TIM_TypeDef::CNT, timer_reg_base>(value);
 }
 
+template<typename Timer>
+void set_prescaler(uint32_t prescaler) MCUTL_NOEXCEPT
+{
+	constexpr auto timer_reg_base = get_timer_register<Timer>();
+	mcutl::memory::set_register_value<&TIM_TypeDef::PSC, timer_reg_base>(prescaler - 1);
+}
+
+template<typename Timer>
+void set_reload_value(uint32_t reload_value) MCUTL_NOEXCEPT
+{
+	constexpr auto timer_reg_base = get_timer_register<Timer>();
+	mcutl::memory::set_register_value<&TIM_TypeDef::ARR, timer_reg_base>(reload_value - 1);
+}
+
+template<typename Timer>
+void generate_update_event() MCUTL_NOEXCEPT
+{
+	constexpr auto timer_reg_base = get_timer_register<Timer>();
+	mcutl::memory::set_register_value<TIM_EGR_UG, &TIM_TypeDef::EGR, timer_reg_base>();
+}
+
 template<typename Interrupt>
 struct interrupt_flag
 {
@@ -493,6 +584,8 @@ struct general_purpose_timer_registers
 	uint32_t cr2 = 0;
 	uint32_t cr1_mask = 0;
 	uint32_t cr2_mask = 0;
+	uint32_t dier = 0;
+	uint32_t dier_mask = 0;
 };
 
 template<typename OptionsLambda>
@@ -547,6 +640,20 @@ constexpr general_purpose_timer_registers get_general_purpose_registers(
 			result.cr2 |= TIM_CR2_MMS_1;
 	}
 	
+	if constexpr (!!options.overflow_set_count)
+	{
+		result.dier_mask |= TIM_DIER_UIE_Msk;
+		if constexpr (!options.overflow.disable)
+			result.dier |= TIM_DIER_UIE;
+	}
+	
+	if constexpr (!!options.update_dma_request_set_count)
+	{
+		result.dier_mask |= TIM_DIER_UDE_Msk;
+		if constexpr (options.update_dma_request)
+			result.dier |= TIM_DIER_UDE;
+	}
+	
 	return result;
 }
 
@@ -603,10 +710,10 @@ void configure_general_purpose_timer(OptionsLambda options_lambda) MCUTL_NOEXCEP
 	}
 	
 	if constexpr (!!options.trigger_registers_update_set_count)
-		mcutl::memory::set_register_value<TIM_EGR_UG, &TIM_TypeDef::EGR, timer_reg_base>();
+		generate_update_event<Timer>();
 	
-	if constexpr (options.overflow_set_count && !options.overflow.disable)
-		mcutl::memory::set_register_value<TIM_DIER_UIE, &TIM_TypeDef::DIER, timer_reg_base>();
+	if constexpr (!!registers.dier)
+		mcutl::memory::set_register_value<registers.dier, &TIM_TypeDef::DIER, timer_reg_base>();
 	else if (!options.base_configuration_set_count)
 		mcutl::memory::set_register_value<0u, &TIM_TypeDef::DIER, timer_reg_base>();
 	
@@ -649,6 +756,80 @@ void configure_general_purpose_timer(OptionsLambda options_lambda) MCUTL_NOEXCEP
 	}
 }
 
+template<typename Timer, typename OptionsLambda>
+constexpr auto get_general_purpose_timer_init_table_builder(OptionsLambda options_lambda) noexcept
+{
+	constexpr auto options = options_lambda();
+	constexpr auto registers = get_general_purpose_registers(options_lambda);
+	constexpr auto timer_reg_base = get_timer_register<Timer>();
+	
+	static_assert(!options.enable_controller_interrupts_set_count
+		&& !options.disable_controller_interrupts_set_count,
+		"Interrupt controller can not be configured using init tables");
+	
+	using periph_builder_t = decltype(mcutl::periph::get_init_table_builder<
+		mcutl::periph::enable<mcutl::timer::peripheral_type<Timer>>>());
+	mcutl::memory::init_table_builder<periph_builder_t::capacity * 2u + 7u> builder;
+	
+	if constexpr (!!options.enable_peripheral_set_count)
+	{
+		if constexpr (options.enable_peripheral)
+		{
+			builder.append(mcutl::periph::get_init_table_builder<
+				mcutl::periph::enable<mcutl::timer::peripheral_type<Timer>>>());
+		}
+	}
+	
+	if (!options.base_configuration_set_count || registers.cr1)
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, CR1), registers.cr1);
+	if (!options.base_configuration_set_count || registers.cr2)
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, CR2), registers.cr2);
+	
+	if constexpr (options.prescaler_set_count && options.prescaler > 1u)
+	{
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, PSC),
+			static_cast<uint32_t>(options.prescaler - 1));
+	}
+	else if (!options.base_configuration_set_count)
+	{
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, PSC), 0u);
+	}
+	
+	if constexpr (!!options.reload_value_set_count)
+	{
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, ARR),
+			static_cast<uint32_t>(options.reload_value - 1));
+	}
+	else if (!options.base_configuration_set_count)
+	{
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, ARR), 0xffffu);
+	}
+	
+	if (options.trigger_registers_update_set_count)
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, EGR), TIM_EGR_UG);
+	
+	if (registers.dier)
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, DIER), registers.dier);
+	else if (!options.base_configuration_set_count)
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, DIER), 0u);
+	
+	if (options.enable_set_count && options.enable)
+		builder.set_value(timer_reg_base + offsetof(TIM_TypeDef, CR1), registers.cr1 | TIM_CR1_CEN);
+	
+	if constexpr (!!options.enable_peripheral_set_count)
+	{
+		if constexpr (!options.enable_peripheral)
+		{
+			static_assert(!options.enable, "Can not enable timer while disabling its peripheral");
+			
+			builder.append(mcutl::periph::get_init_table_builder<
+				mcutl::periph::disable<mcutl::timer::peripheral_type<Timer>>>());
+		}
+	}
+	
+	return builder;
+}
+
 template<typename Timer, typename OptionsLambda>
 void reconfigure_general_purpose_timer(OptionsLambda options_lambda) MCUTL_NOEXCEPT
 {
@@ -699,19 +880,19 @@ void reconfigure_general_purpose_timer(OptionsLambda options_lambda) MCUTL_NOEXC
 	}
 	
 	if constexpr (!!options.trigger_registers_update_set_count)
-		mcutl::memory::set_register_value<TIM_EGR_UG, &TIM_TypeDef::EGR, timer_reg_base>();
+		generate_update_event<Timer>();
 	
 	[[maybe_unused]] uint32_t dier;
 	if constexpr (options.overflow_set_count
+		|| options.update_dma_request_set_count
 		|| options.enable_controller_interrupts_set_count
 		|| options.disable_controller_interrupts_set_count)
 	{
 		dier = mcutl::memory::get_register_bits<&TIM_TypeDef::DIER, timer_reg_base>();
-		if constexpr (!!options.overflow_set_count)
+		if constexpr (!!registers.dier_mask)
 		{
-			dier &= ~TIM_DIER_UIE_Msk;
-			if constexpr (!options.overflow.disable)
-				dier |= TIM_DIER_UIE;
+			dier &= ~registers.dier_mask;
+			dier |= registers.dier;
 			
 			mcutl::memory::set_register_value<&TIM_TypeDef::DIER, timer_reg_base>(dier);
 		}
@@ -783,6 +964,14 @@ void configure(OptionsLambda options_lambda) MCUTL_NOEXCEPT
 		"Selected timer is not supported");
 }
 
+template<typename Timer, typename OptionsLambda>
+constexpr auto get_init_table_builder(OptionsLambda options_lambda) noexcept
+{
+	static_assert(Timer::index >= 2 && Timer::index <= 5,
+		"Selected timer is not supported");
+	return get_general_purpose_timer_init_table_builder<Timer>(options_lambda);
+}
+
 template<typename Timer, typename OptionsLambda>
 void reconfigure(OptionsLambda options_lambda) MCUTL_NOEXCEPT
 {
@@ -793,6 +982,12 @@ void reconfigure(OptionsLambda options_lambda) MCUTL_NOEXCEPT
 		"Selected timer is not supported");
 }
 
+template<typename Timer, typename ClockConfig>
+constexpr auto get_timer_frequency() noexcept
+{
+	return mcutl::timer::detail::timer_traits<Timer>::template get_timer_frequency<ClockConfig>();
+}
+
 template<typename Timer>
 [[maybe_unused]] constexpr bool supports_stop_on_overflow = true;
 template<typename Timer>
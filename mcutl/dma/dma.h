@@ -4,6 +4,7 @@
 
 #include "mcutl/device/dma/device_dma.h"
 #include "mcutl/dma/dma_defs.h"
+#include "mcutl/memory/bus_cost.h"
 #include "mcutl/utils/definitions.h"
 #include "mcutl/utils/options_parser.h"
 
@@ -101,6 +102,21 @@ inline void wait_transfer() MCUTL_NOEXCEPT
 	device::dma::wait_transfer<Channel>();
 }
 
+template<typename Channel, typename... Options>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost configure_channel_cost_v
+	= device::dma::get_configure_dma_cost<Channel>([]() constexpr
+		{ return detail::parse_and_validate_transfer_options<false, Options...>(); });
+
+template<typename Channel, typename... Options>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost reconfigure_channel_cost_v
+	= device::dma::get_reconfigure_dma_cost<Channel>([]() constexpr
+		{ return detail::parse_and_validate_transfer_options<true, Options...>(); });
+
+[[maybe_unused]] constexpr mcutl::memory::bus_cost start_transfer_cost
+	= device::dma::start_transfer_cost;
+[[maybe_unused]] constexpr mcutl::memory::bus_cost wait_transfer_cost
+	= device::dma::wait_transfer_cost;
+
 template<typename Channel, typename... Interrupts>
 inline void clear_pending_flags() MCUTL_NOEXCEPT
 {
@@ -113,4 +129,21 @@ inline void clear_pending_flags_atomic() MCUTL_NOEXCEPT
 	device::dma::clear_pending_flags_atomic<Channel, Interrupts...>();
 }
 
+template<typename Channel, typename... Interrupts>
+[[nodiscard]] inline auto get_pending_flags() MCUTL_NOEXCEPT
+{
+	detail::dma_channel_validator<Channel>::validate();
+	return device::dma::get_pending_flags<Channel, Interrupts...>();
+}
+
+template<typename Channel, typename... Interrupts>
+[[maybe_unused]] constexpr auto pending_flags_v = device::dma::pending_flags_v<Channel, Interrupts...>;
+
+template<typename Channel>
+[[nodiscard]] inline size_type get_remaining_transfers() MCUTL_NOEXCEPT
+{
+	detail::dma_channel_validator<Channel>::validate();
+	return device::dma::get_remaining_transfers<Channel>();
+}
+
 } //namespace mcutl::dma
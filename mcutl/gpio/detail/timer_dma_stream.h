@@ -0,0 +1,45 @@
+#pragma once
+
+#include "mcutl/dma/dma.h"
+#include "mcutl/timer/timer.h"
+#include "mcutl/utils/definitions.h"
+
+namespace mcutl::gpio::detail
+{
+
+//DMA transfer between a GPIO port register and a RAM buffer, which is paced by the
+//Timer update events: each update event requests a single DMA transfer.
+template<typename Timer, typename... DmaOptions>
+struct timer_dma_stream
+{
+	using dma_channel = mcutl::timer::update_dma_channel<Timer>;
+	
+	template<typename Source, typename Destination, typename... TimerOptions>
+	static void configure() MCUTL_NOEXCEPT
+	{
+		mcutl::timer::configure<Timer, TimerOptions...,
+			mcutl::timer::update_dma_request<true>>();
+		dma::configure_channel<dma_channel, Source, Destination, DmaOptions...>();
+	}
+	
+	static void start(const volatile void* from, volatile void* to,
+		dma::size_type size) MCUTL_NOEXCEPT
+	{
+		dma::start_transfer<dma_channel>(from, to, size);
+		mcutl::timer::reconfigure<Timer, mcutl::timer::enable<true>>();
+	}
+	
+	static void stop() MCUTL_NOEXCEPT
+	{
+		mcutl::timer::reconfigure<Timer, mcutl::timer::enable<false>>();
+		dma::reconfigure_channel<dma_channel>();
+	}
+	
+	//Returns the index of the buffer element, which is transferred next
+	[[nodiscard]] static dma::size_type get_position(dma::size_type size) MCUTL_NOEXCEPT
+	{
+		return static_cast<dma::size_type>(size - dma::get_remaining_transfers<dma_channel>());
+	}
+};
+
+} //namespace mcutl::gpio::detail
@@ -4,6 +4,8 @@
 
 #include "mcutl/gpio/gpio_defs.h"
 #include "mcutl/device/gpio/device_gpio.h"
+#include "mcutl/memory/bus_cost.h"
+#include "mcutl/memory/init_table.h"
 #include "mcutl/periph/periph.h"
 #include "mcutl/utils/definitions.h"
 #include "mcutl/utils/type_helpers.h"
@@ -91,6 +93,34 @@ struct configuration_helper
 			device::gpio::configure_gpio<enable_peripherals_requested, pin_config_t>();
 	}
 	
+	static constexpr auto get_init_table_builder() noexcept
+	{
+		using pin_config_t = types::remove_from_container_t<enable_peripherals, config<PinConfig...>>;
+		
+		constexpr bool enable_peripherals_requested
+			= !std::is_same_v<pin_config_t, config<PinConfig...>>;
+		
+		static_assert(pin_config_t::length != 0, "Empty pin configuration");
+		if constexpr (pin_config_t::length && validate_pin_configs(pin_config_t{}))
+			return device::gpio::get_init_table_builder<enable_peripherals_requested, pin_config_t>();
+		else
+			return mcutl::memory::init_table_builder<0>{};
+	}
+	
+	static constexpr mcutl::memory::bus_cost get_configure_cost() noexcept
+	{
+		using pin_config_t = types::remove_from_container_t<enable_peripherals, config<PinConfig...>>;
+		
+		constexpr bool enable_peripherals_requested
+			= !std::is_same_v<pin_config_t, config<PinConfig...>>;
+		
+		static_assert(pin_config_t::length != 0, "Empty pin configuration");
+		if constexpr (pin_config_t::length && validate_pin_configs(pin_config_t{}))
+			return device::gpio::get_configure_gpio_cost<enable_peripherals_requested, pin_config_t>();
+		else
+			return {};
+	}
+	
 	static constexpr auto get_pin_bit_mask() noexcept
 	{
 		if constexpr (!validate_pin_configs(
@@ -108,6 +138,86 @@ struct configuration_helper
 template<typename... PinConfig>
 struct configuration_helper<config<PinConfig...>> : configuration_helper<PinConfig...> {};
 
+template<typename Config>
+struct to_config
+{
+	using type = config<Config>;
+};
+
+template<typename... PinConfig>
+struct to_config<config<PinConfig...>>
+{
+	using type = config<PinConfig...>;
+};
+
+template<typename... Configs>
+struct config_merger
+{
+	using type = types::remove_duplicates_t<
+		types::merge_containers_t<config, typename to_config<Configs>::type...>>;
+	
+	template<typename... PinConfig>
+	static constexpr bool validate(config<PinConfig...>) noexcept
+	{
+		constexpr bool has_conflicts = types::has_duplicates_filtered_v<
+			pin_config_same, PinConfig...>;
+		constexpr bool has_exti_line_conflicts = types::has_duplicates_filtered_v<
+			exti_line_same, PinConfig...>;
+		static_assert(!has_conflicts,
+			"Merged GPIO configurations contain different configurations of the same pin");
+		static_assert(!has_exti_line_conflicts,
+			"Merged GPIO configurations connect different pins to the same EXTI line");
+		return !has_conflicts && !has_exti_line_conflicts;
+	}
+	
+	static constexpr bool valid = validate(
+		types::remove_from_container_t<enable_peripherals, type>{});
+};
+
+template<typename FromConfig, typename ToConfig>
+struct transition_helper
+{
+	using from_config_t = types::remove_from_container_t<enable_peripherals,
+		typename to_config<FromConfig>::type>;
+	using to_config_t = types::remove_from_container_t<enable_peripherals,
+		typename to_config<ToConfig>::type>;
+	
+	static constexpr bool enable_peripherals_requested
+		= !std::is_same_v<to_config_t, typename to_config<ToConfig>::type>;
+	
+	static constexpr bool validate() noexcept
+	{
+		static_assert(from_config_t::length != 0, "Empty source pin configuration");
+		static_assert(to_config_t::length != 0, "Empty target pin configuration");
+		if constexpr (from_config_t::length && to_config_t::length)
+			return validate_pin_configs(from_config_t{}) && validate_pin_configs(to_config_t{});
+		else
+			return false;
+	}
+	
+	static void transition() MCUTL_NOEXCEPT
+	{
+		if constexpr (validate())
+		{
+			device::gpio::transition<enable_peripherals_requested,
+				from_config_t, to_config_t>();
+		}
+	}
+	
+	static constexpr mcutl::memory::bus_cost get_transition_cost() noexcept
+	{
+		if constexpr (validate())
+		{
+			return device::gpio::get_transition_cost<enable_peripherals_requested,
+				from_config_t, to_config_t>();
+		}
+		else
+		{
+			return {};
+		}
+	}
+};
+
 } //namespace detail
 
 template<typename... PinConfig>
@@ -116,10 +226,45 @@ void configure_gpio() MCUTL_NOEXCEPT
 	detail::configuration_helper<PinConfig...>::configure_gpio();
 }
 
+template<typename... PinConfig>
+[[nodiscard]] constexpr auto get_init_table_builder() noexcept
+{
+	return detail::configuration_helper<PinConfig...>::get_init_table_builder();
+}
+
+template<typename... PinConfig>
+[[nodiscard]] constexpr auto get_init_table() noexcept
+{
+	return mcutl::memory::make_init_table(
+		[] () constexpr { return get_init_table_builder<PinConfig...>(); });
+}
+
+template<typename... PinConfig>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost configure_gpio_cost_v
+	= detail::configuration_helper<PinConfig...>::get_configure_cost();
+
 template<typename... PinConfigs>
 [[maybe_unused]] constexpr auto pin_bit_mask_v
 	= detail::configuration_helper<PinConfigs...>::get_pin_bit_mask();
 
+//Switches pins from FromConfig, which must describe their current configuration
+//and output values, to ToConfig. Only the differing configuration bits are written.
+template<typename FromConfig, typename ToConfig>
+void transition() MCUTL_NOEXCEPT
+{
+	detail::transition_helper<FromConfig, ToConfig>::transition();
+}
+
+template<typename FromConfig, typename ToConfig>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost transition_cost_v
+	= detail::transition_helper<FromConfig, ToConfig>::get_transition_cost();
+
+//Merges several GPIO configurations (or single pin configurations) into one.
+//Identical pin configurations are kept once, conflicting ones are rejected at compile time.
+template<typename... Configs>
+using merged_config = std::enable_if_t<detail::config_merger<Configs...>::valid,
+	typename detail::config_merger<Configs...>::type>;
+
 template<typename Pin, typename Value, typename... OutputOptions>
 void set_out_value() MCUTL_NOEXCEPT
 {
@@ -158,6 +303,69 @@ void set_zero_atomic() MCUTL_NOEXCEPT
 	set_out_value_atomic<Pin, out::zero>();
 }
 
+namespace detail
+{
+
+template<typename PinConfig>
+struct is_to_value : std::false_type {};
+
+template<typename Pin, typename Value, typename... OutputOptions>
+struct is_to_value<to_value<Pin, Value, OutputOptions...>> : std::true_type {};
+
+template<typename... Pins>
+constexpr bool validate_group_pins() noexcept
+{
+	static_assert(sizeof...(Pins) != 0, "Empty pin group");
+	static_assert(sizeof...(Pins) <= 32u, "Pin group can not contain more than 32 pins");
+	return sizeof...(Pins) != 0 && sizeof...(Pins) <= 32u
+		&& validate_pin_configs(config<to_value<Pins, out::one>...>{});
+}
+
+} //namespace detail
+
+template<typename... ValueConfig>
+void set_values() MCUTL_NOEXCEPT
+{
+	static_assert((... && detail::is_to_value<ValueConfig>::value),
+		"gpio::set_values() accepts only gpio::to_value pin configurations");
+	configure_gpio<ValueConfig...>();
+}
+
+template<typename... Pins>
+void write_group(uint32_t value_mask) MCUTL_NOEXCEPT
+{
+	if constexpr (detail::validate_group_pins<Pins...>())
+		device::gpio::write_group<Pins...>(value_mask);
+}
+
+template<typename... Pins>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost write_group_cost_v
+	= device::gpio::get_write_group_cost<Pins...>();
+
+template<uint32_t ChunkBits, typename... Pins>
+struct basic_parallel_bus
+{
+	static_assert(ChunkBits == 4u || ChunkBits == 8u, "Parallel bus chunk must be 4 or 8 bits wide");
+	
+	static constexpr uint32_t width = sizeof...(Pins);
+	static constexpr mcutl::memory::bus_cost write_cost = write_group_cost_v<Pins...>;
+	
+	template<typename... OutputOptions>
+	using gpio_config = config<as_output<Pins, out::push_pull, out::keep_value, OutputOptions...>...>;
+	
+	static void write(uint32_t value) MCUTL_NOEXCEPT
+	{
+		if constexpr (detail::validate_group_pins<Pins...>())
+			device::gpio::write_parallel_bus<ChunkBits, Pins...>(value);
+	}
+};
+
+template<typename... Pins>
+using parallel_bus = basic_parallel_bus<8u, Pins...>;
+
+template<typename... Pins>
+using compact_parallel_bus = basic_parallel_bus<4u, Pins...>;
+
 template<bool NegateBits, typename... Pins>
 [[nodiscard]] auto get_input_values_mask() MCUTL_NOEXCEPT
 {
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+
+#include "mcutl/device/gpio/device_gpio.h"
+#include "mcutl/dma/dma.h"
+#include "mcutl/gpio/detail/timer_dma_stream.h"
+#include "mcutl/utils/definitions.h"
+
+namespace mcutl::gpio
+{
+
+template<char PortLetter, typename Timer, typename... DmaOptions>
+struct port_sampler
+{
+	using timer = Timer;
+	using dma_channel = mcutl::timer::update_dma_channel<Timer>;
+	using sample_type = uint16_t;
+	
+	static constexpr char port_letter = PortLetter;
+	
+	template<typename... TimerOptions>
+	static void configure() MCUTL_NOEXCEPT
+	{
+		stream::template configure<
+			dma::source<dma::data_size::halfword, dma::address::peripheral, dma::pointer_increment::disabled>,
+			dma::destination<dma::data_size::halfword, dma::address::memory, dma::pointer_increment::enabled>,
+			TimerOptions...
+		>();
+	}
+	
+	static void start(volatile sample_type* buffer, dma::size_type size) MCUTL_NOEXCEPT
+	{
+		stream::start(device::gpio::get_input_values_register<PortLetter>(), buffer, size);
+	}
+	
+	static void stop() MCUTL_NOEXCEPT
+	{
+		stream::stop();
+	}
+	
+	[[nodiscard]] static dma::size_type get_write_position(dma::size_type size) MCUTL_NOEXCEPT
+	{
+		return stream::get_position(size);
+	}
+	
+private:
+	using stream = detail::timer_dma_stream<Timer, dma::mode::circular, DmaOptions...>;
+};
+
+} //namespace mcutl::gpio
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mcutl/device/gpio/device_gpio.h"
+#include "mcutl/dma/dma.h"
+#include "mcutl/gpio/detail/timer_dma_stream.h"
+#include "mcutl/gpio/gpio.h"
+#include "mcutl/utils/definitions.h"
+
+namespace mcutl::gpio
+{
+
+template<typename... Pins>
+struct waveform_pins
+{
+	static_assert(detail::validate_group_pins<Pins...>(), "Invalid waveform pins");
+	
+	using word_type = device::gpio::port_write_word_type;
+	
+	static constexpr uint32_t width = sizeof...(Pins);
+	static constexpr char port_letter
+		= device::gpio::pin_port_letter_helper<Pins...>::get_first_pin_port_letter();
+	static_assert((... && (Pins::port_letter == port_letter)),
+		"All waveform pins must belong to the same port");
+	
+	template<typename... OutputOptions>
+	using gpio_config = config<as_output<Pins, out::push_pull, out::keep_value, OutputOptions...>...>;
+	
+	[[nodiscard]] static constexpr word_type to_word(uint32_t value) noexcept
+	{
+		return device::gpio::get_port_write_word<Pins...>(value);
+	}
+	
+	template<typename Value, size_t Size>
+	[[nodiscard]] static constexpr std::array<word_type, Size> make_table(
+		const std::array<Value, Size>& pattern) noexcept
+	{
+		std::array<word_type, Size> table {};
+		for (size_t i = 0; i != Size; ++i)
+			table[i] = to_word(static_cast<uint32_t>(pattern[i]));
+		return table;
+	}
+	
+	template<typename Value>
+	static void fill(volatile word_type* words, const Value* pattern, size_t count) MCUTL_NOEXCEPT
+	{
+		for (size_t i = 0; i != count; ++i)
+			words[i] = to_word(static_cast<uint32_t>(pattern[i]));
+	}
+};
+
+template<typename Timer, typename WaveformPins, typename... DmaOptions>
+struct waveform_generator
+{
+	using timer = Timer;
+	using pins = WaveformPins;
+	using dma_channel = mcutl::timer::update_dma_channel<Timer>;
+	using word_type = typename WaveformPins::word_type;
+	
+	template<typename... TimerOptions>
+	static void configure() MCUTL_NOEXCEPT
+	{
+		stream::template configure<
+			dma::source<dma::data_size::word, dma::address::memory, dma::pointer_increment::enabled>,
+			dma::destination<dma::data_size::word, dma::address::peripheral, dma::pointer_increment::disabled>,
+			TimerOptions...
+		>();
+	}
+	
+	static void start(const volatile word_type* table, dma::size_type size) MCUTL_NOEXCEPT
+	{
+		stream::start(table, device::gpio::get_port_write_register<WaveformPins::port_letter>(), size);
+	}
+	
+	static void stop() MCUTL_NOEXCEPT
+	{
+		stream::stop();
+	}
+	
+	[[nodiscard]] static dma::size_type get_read_position(dma::size_type size) MCUTL_NOEXCEPT
+	{
+		return stream::get_position(size);
+	}
+	
+	//Returns the offset of the table half, which is not being output currently
+	//and can be refilled (circular mode)
+	[[nodiscard]] static dma::size_type get_free_half_offset(dma::size_type size) MCUTL_NOEXCEPT
+	{
+		const auto half = static_cast<dma::size_type>(size / 2u);
+		return get_read_position(size) < half ? half : dma::size_type {};
+	}
+	
+private:
+	using stream = detail::timer_dma_stream<Timer, DmaOptions...>;
+};
+
+} //namespace mcutl::gpio
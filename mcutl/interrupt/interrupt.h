@@ -2,6 +2,7 @@
 
 #include "mcutl/interrupt/interrupt_defs.h"
 #include "mcutl/device/interrupt/device_interrupt.h"
+#include "mcutl/memory/bus_cost.h"
 #include "mcutl/utils/definitions.h"
 
 namespace mcutl::interrupt
@@ -147,4 +148,27 @@ inline void clear_pending_atomic() MCUTL_NOEXCEPT
 	device::interrupt::clear_pending_atomic<typename traits::interrupt_type>();
 }
 
+namespace detail
+{
+
+template<typename Interrupt>
+constexpr mcutl::memory::bus_cost get_enable_cost() noexcept
+{
+	using traits = interrupt_traits<Interrupt>;
+	auto cost = device::interrupt::get_enable_cost<typename traits::interrupt_type>();
+	if constexpr (has_priorities && traits::priority != default_priority)
+		cost += device::interrupt::get_set_priority_cost<typename traits::interrupt_type>();
+	return cost;
+}
+
+} //namespace detail
+
+template<typename Interrupt>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost enable_cost_v
+	= detail::get_enable_cost<Interrupt>();
+
+template<typename Interrupt>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost disable_cost_v
+	= device::interrupt::get_disable_cost<typename detail::interrupt_traits<Interrupt>::interrupt_type>();
+
 } //namespace mcutl::interrupt
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+
+#include "mcutl/memory/shadow_register.h"
+#include "mcutl/memory/volatile_memory.h"
+#include "mcutl/utils/type_helpers.h"
+
+namespace mcutl::memory
+{
+
+//Default count of CPU cycles spent for a single peripheral bus access
+[[maybe_unused]] constexpr uint32_t default_bus_access_cycles = 2;
+
+struct bus_cost
+{
+	//Count of register reads, including a single read for each polling loop
+	uint32_t reads = 0;
+	//Count of register writes
+	uint32_t writes = 0;
+	//Count of loops which poll a register until a hardware flag changes.
+	//The duration of such loops depends on the hardware and is not bounded.
+	uint32_t polling_loops = 0;
+	
+	[[nodiscard]] constexpr uint32_t accesses() const noexcept
+	{
+		return reads + writes;
+	}
+	
+	[[nodiscard]] constexpr bool is_bounded() const noexcept
+	{
+		return !polling_loops;
+	}
+	
+	//Cycles spent for bus accesses, not including the time to wait for polled flags
+	[[nodiscard]] constexpr uint32_t get_fixed_cycles(
+		uint32_t cycles_per_access = default_bus_access_cycles) const noexcept
+	{
+		return accesses() * cycles_per_access;
+	}
+	
+	constexpr bus_cost& operator+=(const bus_cost& other) noexcept
+	{
+		reads += other.reads;
+		writes += other.writes;
+		polling_loops += other.polling_loops;
+		return *this;
+	}
+	
+	[[nodiscard]] constexpr bus_cost operator+(const bus_cost& other) const noexcept
+	{
+		bus_cost result = *this;
+		return result += other;
+	}
+	
+	[[nodiscard]] constexpr bool operator==(const bus_cost& other) const noexcept
+	{
+		return reads == other.reads && writes == other.writes
+			&& polling_loops == other.polling_loops;
+	}
+	
+	[[nodiscard]] constexpr bool operator!=(const bus_cost& other) const noexcept
+	{
+		return !(*this == other);
+	}
+};
+
+[[maybe_unused]] constexpr bus_cost read_cost { 1u, 0u, 0u };
+[[maybe_unused]] constexpr bus_cost write_cost { 0u, 1u, 0u };
+[[maybe_unused]] constexpr bus_cost poll_cost { 1u, 0u, 1u };
+
+//Returns the cost of either of two alternative code paths
+[[nodiscard]] constexpr bus_cost worst_case(const bus_cost& first, const bus_cost& second) noexcept
+{
+	return {
+		first.reads > second.reads ? first.reads : second.reads,
+		first.writes > second.writes ? first.writes : second.writes,
+		first.polling_loops > second.polling_loops ? first.polling_loops : second.polling_loops
+	};
+}
+
+namespace detail
+{
+
+template<bool HasBits, bool NeedsRead>
+constexpr bus_cost get_set_bits_cost() noexcept
+{
+	if constexpr (!HasBits)
+		return {};
+	else if constexpr (NeedsRead)
+		return read_cost + write_cost;
+	else
+		return write_cost;
+}
+
+template<auto BitMask, auto Reg, uintptr_t RegStructBase>
+constexpr bus_cost get_set_shadowed_register_bits_cost() noexcept
+{
+	using reg_type = std::remove_cv_t<types::type_of_member_pointer_t<Reg>>;
+	if constexpr (!static_cast<std::make_unsigned_t<reg_type>>(BitMask))
+		return {};
+	else if constexpr (!is_register_shadowed_v<Reg, RegStructBase>)
+	{
+		return get_set_bits_cost<true,
+			device::memory::set_register_bits_needs_read<BitMask, Reg, RegStructBase>()>();
+	}
+	else if constexpr (shadow_register_traits<Reg, RegStructBase>::mode == shadow_mode::checked)
+		return read_cost + write_cost;
+	else
+		return write_cost;
+}
+
+} //namespace detail
+
+template<auto BitMask, auto Reg, uintptr_t RegStructBase>
+[[maybe_unused]] constexpr bus_cost set_register_bits_cost_v = detail::get_set_bits_cost<
+	!!static_cast<std::make_unsigned_t<std::remove_cv_t<types::type_of_member_pointer_t<Reg>>>>(BitMask),
+	device::memory::set_register_bits_needs_read<BitMask, Reg, RegStructBase>()>();
+
+template<auto BitMask, auto Reg, size_t RegArrIndex, uintptr_t RegStructBase>
+[[maybe_unused]] constexpr bus_cost set_register_array_bits_cost_v = detail::get_set_bits_cost<
+	!!static_cast<std::make_unsigned_t<std::remove_cv_t<std::remove_all_extents_t<
+		types::type_of_member_pointer_t<Reg>>>>>(BitMask),
+	device::memory::set_register_array_bits_needs_read<BitMask, Reg, RegArrIndex, RegStructBase>()>();
+
+template<auto BitMask, auto Reg, uintptr_t RegStructBase>
+[[maybe_unused]] constexpr bus_cost set_shadowed_register_bits_cost_v
+	= detail::get_set_shadowed_register_bits_cost<BitMask, Reg, RegStructBase>();
+
+} //namespace mcutl::memory
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mcutl/memory/bus_cost.h"
+#include "mcutl/memory/volatile_memory.h"
+#include "mcutl/utils/definitions.h"
+
+namespace mcutl::memory
+{
+
+struct init_record
+{
+	uintptr_t address;
+	uint32_t mask;
+	uint32_t value;
+	uint32_t wait_mask;
+	uint32_t wait_value;
+};
+
+template<size_t Capacity>
+class init_table_builder
+{
+public:
+	static constexpr size_t capacity = Capacity;
+
+public:
+	constexpr init_table_builder& set_bits(uintptr_t address,
+		uint32_t mask, uint32_t value) noexcept
+	{
+		if (mask)
+			add({ address, mask, value & mask, 0u, 0u });
+		return *this;
+	}
+	
+	constexpr init_table_builder& set_value(uintptr_t address, uint32_t value) noexcept
+	{
+		return set_bits(address, max_bitmask<uint32_t>, value);
+	}
+	
+	constexpr init_table_builder& read(uintptr_t address) noexcept
+	{
+		add({ address, 0u, 0u, 0u, 0u });
+		return *this;
+	}
+	
+	constexpr init_table_builder& wait(uintptr_t address,
+		uint32_t wait_mask, uint32_t wait_value) noexcept
+	{
+		add({ address, 0u, 0u, wait_mask, wait_value & wait_mask });
+		return *this;
+	}
+	
+	template<size_t Size>
+	constexpr init_table_builder& append(const std::array<init_record, Size>& table) noexcept
+	{
+		for (const auto& record : table)
+			add(record);
+		return *this;
+	}
+	
+	template<size_t OtherCapacity>
+	constexpr init_table_builder& append(const init_table_builder<OtherCapacity>& builder) noexcept
+	{
+		for (size_t i = 0; i != builder.size(); ++i)
+			add(builder[i]);
+		return *this;
+	}
+	
+	constexpr size_t size() const noexcept
+	{
+		return size_;
+	}
+	
+	constexpr const init_record& operator[](size_t index) const noexcept
+	{
+		return records_[index];
+	}
+
+private:
+	constexpr void add(const init_record& record) noexcept
+	{
+		records_[size_++] = record;
+	}
+
+private:
+	std::array<init_record, Capacity> records_ {};
+	size_t size_ = 0;
+};
+
+template<typename BuilderLambda>
+[[nodiscard]] constexpr auto make_init_table(BuilderLambda builder_lambda) noexcept
+{
+	constexpr auto builder = builder_lambda();
+	std::array<init_record, builder.size()> result {};
+	for (size_t i = 0; i != builder.size(); ++i)
+		result[i] = builder[i];
+	return result;
+}
+
+template<size_t... Sizes>
+[[nodiscard]] constexpr auto join_init_tables(
+	const std::array<init_record, Sizes>&... tables) noexcept
+{
+	std::array<init_record, (0 + ... + Sizes)> result {};
+	size_t index = 0;
+	(..., [&result, &index] (const auto& table) constexpr {
+		for (const auto& record : table)
+			result[index++] = record;
+	}(tables));
+	return result;
+}
+
+template<size_t Size>
+[[nodiscard]] constexpr bus_cost get_init_table_cost(
+	const std::array<init_record, Size>& table) noexcept
+{
+	bus_cost result {};
+	for (const auto& record : table)
+	{
+		if (record.mask)
+		{
+			if (record.mask != max_bitmask<uint32_t>)
+				result += read_cost;
+			result += write_cost;
+		}
+		else if (!record.wait_mask)
+		{
+			result += read_cost;
+		}
+		
+		if (record.wait_mask)
+			result += poll_cost;
+	}
+	return result;
+}
+
+namespace detail
+{
+
+struct init_register
+{
+	uint32_t value;
+};
+
+} //namespace detail
+
+MCUTL_NOINLINE inline void apply_init_table(const init_record* records, size_t count) MCUTL_NOEXCEPT
+{
+	for (const auto* record = records, *end = records + count; record != end; ++record)
+	{
+		auto reg = volatile_memory<detail::init_register>(record->address);
+		if (record->mask)
+		{
+			auto value = record->value;
+			if (record->mask != max_bitmask<uint32_t>)
+				value |= get_register_bits(&detail::init_register::value, reg) & ~record->mask;
+			set_register_value(&detail::init_register::value, reg, value);
+		}
+		else if (!record->wait_mask)
+		{
+			[[maybe_unused]] auto value = get_register_bits(&detail::init_register::value, reg);
+		}
+		
+		if (record->wait_mask)
+		{
+			while ((get_register_bits(&detail::init_register::value, reg) & record->wait_mask)
+				!= record->wait_value)
+			{
+			}
+		}
+	}
+}
+
+template<size_t Size>
+inline void apply_init_table(const std::array<init_record, Size>& table) MCUTL_NOEXCEPT
+{
+	if constexpr (Size != 0)
+		apply_init_table(table.data(), Size);
+}
+
+} //namespace mcutl::memory
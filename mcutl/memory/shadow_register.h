@@ -0,0 +1,110 @@
+#pragma once
+
+#include <stdint.h>
+#include <type_traits>
+
+#include "mcutl/memory/volatile_memory.h"
+#include "mcutl/utils/definitions.h"
+#include "mcutl/utils/type_helpers.h"
+
+namespace mcutl::memory
+{
+
+enum class shadow_mode
+{
+	disabled,
+	enabled,
+	checked
+};
+
+template<auto Reg, uintptr_t RegStructBase>
+struct shadow_register_traits
+{
+	static constexpr auto mode = shadow_mode::disabled;
+};
+
+template<auto ResetValue, shadow_mode Mode = shadow_mode::enabled>
+struct shadowed_register
+{
+	static_assert(Mode != shadow_mode::disabled, "Invalid shadow register mode");
+	
+	static constexpr auto mode = Mode;
+	static constexpr auto reset_value = ResetValue;
+};
+
+template<auto Reg, uintptr_t RegStructBase>
+[[maybe_unused]] constexpr bool is_register_shadowed_v
+	= shadow_register_traits<Reg, RegStructBase>::mode != shadow_mode::disabled;
+
+namespace detail
+{
+
+template<auto Reg, uintptr_t RegStructBase>
+struct shadow_storage
+{
+	static_assert(is_register_shadowed_v<Reg, RegStructBase>, "Register is not shadowed");
+	
+	using register_type = std::remove_cv_t<types::type_of_member_pointer_t<Reg>>;
+	
+	static inline register_type value = static_cast<register_type>(
+		shadow_register_traits<Reg, RegStructBase>::reset_value);
+	static inline uint32_t mismatch_count = 0;
+};
+
+} //namespace detail
+
+template<auto Reg, uintptr_t RegStructBase>
+inline void load_shadow_register() MCUTL_NOEXCEPT
+{
+	detail::shadow_storage<Reg, RegStructBase>::value = get_register_bits<Reg, RegStructBase>();
+}
+
+template<auto Reg, uintptr_t RegStructBase>
+[[nodiscard]] inline auto get_shadow_register_value() noexcept
+{
+	return detail::shadow_storage<Reg, RegStructBase>::value;
+}
+
+template<auto Reg, uintptr_t RegStructBase>
+[[nodiscard]] inline uint32_t get_shadow_register_mismatch_count() noexcept
+{
+	static_assert(shadow_register_traits<Reg, RegStructBase>::mode == shadow_mode::checked,
+		"Shadow register mismatches are counted in checked mode only");
+	return detail::shadow_storage<Reg, RegStructBase>::mismatch_count;
+}
+
+template<auto BitMask, auto BitValues, auto Reg, uintptr_t RegStructBase>
+inline void set_shadowed_register_bits() MCUTL_NOEXCEPT
+{
+	using reg_type = std::remove_cv_t<types::type_of_member_pointer_t<Reg>>;
+	constexpr auto unsigned_bitmask = static_cast<std::make_unsigned_t<reg_type>>(BitMask);
+	if constexpr (!unsigned_bitmask)
+	{
+		return;
+	}
+	else if constexpr (!is_register_shadowed_v<Reg, RegStructBase>)
+	{
+		set_register_bits<BitMask, BitValues, Reg, RegStructBase>();
+	}
+	else
+	{
+		using storage = detail::shadow_storage<Reg, RegStructBase>;
+		reg_type value = storage::value;
+		if constexpr (shadow_register_traits<Reg, RegStructBase>::mode == shadow_mode::checked)
+		{
+			reg_type actual_value = get_register_bits<Reg, RegStructBase>();
+			if (actual_value != value)
+			{
+				++storage::mismatch_count;
+				value = actual_value;
+			}
+		}
+		
+		value &= ~unsigned_bitmask;
+		value |= (BitValues & unsigned_bitmask);
+		storage::value = value;
+		set_register_value<Reg, RegStructBase>(value);
+	}
+}
+
+} //namespace mcutl::memory
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <stdint.h>
 #include <type_traits>
+#include <utility>
 
 #ifdef MCUTL_TEST
 #	include "mcutl/tests/volatile_memory.h"
@@ -467,4 +469,251 @@ inline void set_register_array_value(RegType RegStruct::*reg_ptr) MCUTL_NOEXCEPT
 		RegArrIndex, RegStructBase>(reg_ptr);
 }
 
+namespace detail
+{
+
+template<auto Reg, size_t RegArrIndex, uintptr_t RegStructBase>
+struct register_key {};
+
+template<typename RegType, auto BitMask, auto BitValues>
+struct register_bits_base
+{
+	using register_type = std::remove_cv_t<RegType>;
+	using unsigned_register_type = std::make_unsigned_t<register_type>;
+	
+	static constexpr auto bit_mask = static_cast<unsigned_register_type>(BitMask);
+	static constexpr auto bit_values = static_cast<unsigned_register_type>(
+		static_cast<unsigned_register_type>(BitValues) & bit_mask);
+};
+
+template<typename... Ops>
+class register_transaction
+{
+private:
+	using ops_list = types::list<Ops...>;
+	using keys_list = types::list<typename Ops::register_key...>;
+	
+	template<typename Key, typename Op>
+	static constexpr uint64_t get_mask_for_key() noexcept
+	{
+		if constexpr (std::is_same_v<Key, typename Op::register_key>)
+			return Op::bit_mask;
+		else
+			return 0u;
+	}
+	
+	template<typename Key>
+	static constexpr uint64_t get_merged_mask() noexcept
+	{
+		return (0u | ... | get_mask_for_key<Key, Ops>());
+	}
+	
+	template<typename Key>
+	static constexpr uint64_t get_merged_values() noexcept
+	{
+		uint64_t values = 0u;
+		((values = (values & ~get_mask_for_key<Key, Ops>())
+			| (static_cast<uint64_t>(Ops::bit_values) & get_mask_for_key<Key, Ops>())), ...);
+		return values;
+	}
+	
+	template<size_t Index>
+	static void apply_register() MCUTL_NOEXCEPT
+	{
+		using key = types::type_by_index_t<Index, keys_list>;
+		if constexpr (types::type_index_v<key, keys_list> == Index)
+		{
+			using op = types::type_by_index_t<Index, ops_list>;
+			using unsigned_register_type = typename op::unsigned_register_type;
+			op::template apply<static_cast<unsigned_register_type>(get_merged_mask<key>()),
+				static_cast<unsigned_register_type>(get_merged_values<key>())>();
+		}
+	}
+	
+	template<size_t... Indexes>
+	static void apply(std::index_sequence<Indexes...>) MCUTL_NOEXCEPT
+	{
+		(..., apply_register<Indexes>());
+	}
+	
+public:
+	static void apply() MCUTL_NOEXCEPT
+	{
+		apply(std::make_index_sequence<sizeof...(Ops)>());
+	}
+};
+
+} //namespace detail
+
+template<auto BitMask, auto BitValues, auto Reg, uintptr_t RegStructBase>
+struct register_bits : detail::register_bits_base<types::type_of_member_pointer_t<Reg>,
+	BitMask, BitValues>
+{
+	static_assert(std::is_member_object_pointer_v<decltype(Reg)>,
+		"Reg must be a pointer to register struct member");
+	
+	using register_key = detail::register_key<Reg, static_cast<size_t>(-1), RegStructBase>;
+	
+	template<auto MergedBitMask, auto MergedBitValues>
+	static void apply() MCUTL_NOEXCEPT
+	{
+		set_register_bits<MergedBitMask, MergedBitValues, Reg, RegStructBase>();
+	}
+};
+
+template<auto Value, auto Reg, uintptr_t RegStructBase>
+struct register_value : register_bits<max_bitmask<std::make_unsigned_t<
+	std::remove_cv_t<types::type_of_member_pointer_t<Reg>>>>, Value, Reg, RegStructBase>
+{
+};
+
+template<auto BitMask, auto BitValues, auto Reg, size_t RegArrIndex, uintptr_t RegStructBase>
+struct register_array_bits : detail::register_bits_base<
+	std::remove_all_extents_t<types::type_of_member_pointer_t<Reg>>, BitMask, BitValues>
+{
+	static_assert(std::is_member_object_pointer_v<decltype(Reg)>,
+		"Reg must be a pointer to register struct member");
+	static_assert(RegArrIndex < std::extent_v<types::type_of_member_pointer_t<Reg>>, "Invalid array index");
+	
+	using register_key = detail::register_key<Reg, RegArrIndex, RegStructBase>;
+	
+	template<auto MergedBitMask, auto MergedBitValues>
+	static void apply() MCUTL_NOEXCEPT
+	{
+		set_register_array_bits<MergedBitMask, MergedBitValues, Reg, RegArrIndex, RegStructBase>();
+	}
+};
+
+template<auto Value, auto Reg, size_t RegArrIndex, uintptr_t RegStructBase>
+struct register_array_value : register_array_bits<max_bitmask<std::make_unsigned_t<
+		std::remove_cv_t<std::remove_all_extents_t<types::type_of_member_pointer_t<Reg>>>>>,
+	Value, Reg, RegArrIndex, RegStructBase>
+{
+};
+
+template<typename... Ops>
+inline void set_registers() MCUTL_NOEXCEPT
+{
+	detail::register_transaction<Ops...>::apply();
+}
+
+template<typename RegStruct, uintptr_t RegStructBase>
+class register_block
+{
+public:
+	using register_struct_type = RegStruct;
+	static constexpr uintptr_t base = RegStructBase;
+	
+public:
+	register_block() noexcept
+		: ptr_(device::memory::pinned_volatile_memory<RegStruct, RegStructBase>())
+	{
+	}
+	
+	[[nodiscard]] volatile RegStruct* get() const noexcept
+	{
+		return ptr_;
+	}
+	
+private:
+	volatile RegStruct* ptr_;
+};
+
+template<auto BitMask, auto BitValues, auto Reg, typename RegStruct, uintptr_t RegStructBase>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_bits(
+	const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	set_register_bits<BitMask, BitValues, Reg>(block.get());
+}
+
+template<auto BitMask, auto Reg, typename RegStruct, uintptr_t RegStructBase>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_bits(
+	const register_block<RegStruct, RegStructBase>& block,
+	std::remove_cv_t<types::type_of_member_pointer_t<Reg>> value) MCUTL_NOEXCEPT
+{
+	set_register_bits<BitMask, Reg>(block.get(), value);
+}
+
+template<auto Value, auto Reg, typename RegStruct, uintptr_t RegStructBase>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_value(
+	const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	set_register_value<Value, Reg>(block.get());
+}
+
+template<auto Reg, typename RegStruct, uintptr_t RegStructBase, typename Value>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_value(
+	const register_block<RegStruct, RegStructBase>& block, Value value) MCUTL_NOEXCEPT
+{
+	set_register_value<Reg>(block.get(), value);
+}
+
+template<auto Reg, typename RegStruct, uintptr_t RegStructBase>
+[[nodiscard]] inline auto get_register_bits(
+	const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	return get_register_bits<Reg>(block.get());
+}
+
+template<auto BitMask, auto Reg, typename RegStruct, uintptr_t RegStructBase>
+[[nodiscard]] inline auto get_register_bits(
+	const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	return get_register_bits<BitMask, Reg>(block.get());
+}
+
+template<auto BitMask, auto Reg, typename RegStruct, uintptr_t RegStructBase>
+[[nodiscard]] inline bool get_register_flag(const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	return get_register_flag<BitMask, Reg>(block.get());
+}
+
+template<auto BitMask, auto BitValues, auto Reg, size_t RegArrIndex,
+	typename RegStruct, uintptr_t RegStructBase>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_array_bits(
+	const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	set_register_array_bits<BitMask, BitValues, Reg, RegArrIndex>(block.get());
+}
+
+template<auto BitMask, auto Reg, size_t RegArrIndex, typename RegStruct, uintptr_t RegStructBase>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_array_bits(
+	const register_block<RegStruct, RegStructBase>& block,
+	std::remove_cv_t<std::remove_all_extents_t<types::type_of_member_pointer_t<Reg>>> value) MCUTL_NOEXCEPT
+{
+	set_register_array_bits<BitMask, Reg, RegArrIndex>(block.get(), value);
+}
+
+template<auto Value, auto Reg, size_t RegArrIndex, typename RegStruct, uintptr_t RegStructBase>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_array_value(
+	const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	set_register_array_value<Value, Reg, RegArrIndex>(block.get());
+}
+
+template<auto Reg, size_t RegArrIndex, typename RegStruct, uintptr_t RegStructBase, typename Value>
+inline std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>> set_register_array_value(
+	const register_block<RegStruct, RegStructBase>& block, Value value) MCUTL_NOEXCEPT
+{
+	set_register_array_value<Reg, RegArrIndex>(block.get(), value);
+}
+
+template<auto Reg, size_t RegArrIndex, typename RegStruct, uintptr_t RegStructBase>
+[[nodiscard]] inline auto get_register_array_bits(const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	return get_register_array_bits<Reg, RegArrIndex>(block.get());
+}
+
+template<auto BitMask, auto Reg, size_t RegArrIndex, typename RegStruct, uintptr_t RegStructBase>
+[[nodiscard]] inline auto get_register_array_bits(const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	return get_register_array_bits<BitMask, Reg, RegArrIndex>(block.get());
+}
+
+template<auto BitMask, auto Reg, size_t RegArrIndex, typename RegStruct, uintptr_t RegStructBase>
+[[nodiscard]] inline bool get_register_array_flag(const register_block<RegStruct, RegStructBase>& block) MCUTL_NOEXCEPT
+{
+	return get_register_array_flag<BitMask, Reg, RegArrIndex>(block.get());
+}
+
 } //namespace mcutl::memory
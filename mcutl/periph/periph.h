@@ -2,6 +2,8 @@
 
 #include "mcutl/periph/periph_defs.h"
 #include "mcutl/device/periph/device_periph.h"
+#include "mcutl/memory/bus_cost.h"
+#include "mcutl/memory/init_table.h"
 #include "mcutl/utils/definitions.h"
 
 namespace mcutl::periph
@@ -46,4 +48,23 @@ void configure_peripheral() MCUTL_NOEXCEPT
 		[] () constexpr { return detail::config_helper<PeripheralConfig...>::get_and_validate_config(); });
 }
 
+template<typename... PeripheralConfig>
+[[nodiscard]] constexpr auto get_init_table_builder() noexcept
+{
+	return device::periph::get_init_table_builder(
+		[] () constexpr { return detail::config_helper<PeripheralConfig...>::get_and_validate_config(); });
+}
+
+template<typename... PeripheralConfig>
+[[nodiscard]] constexpr auto get_init_table() noexcept
+{
+	return mcutl::memory::make_init_table(
+		[] () constexpr { return get_init_table_builder<PeripheralConfig...>(); });
+}
+
+template<typename... PeripheralConfig>
+[[maybe_unused]] constexpr mcutl::memory::bus_cost configure_peripheral_cost_v
+	= device::periph::get_configure_peripheral_cost(
+		[] () constexpr { return detail::config_helper<PeripheralConfig...>::get_and_validate_config(); });
+
 } //namespace mcutl::periph
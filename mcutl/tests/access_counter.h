@@ -0,0 +1,171 @@
+#pragma once
+
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "mcutl/tests/volatile_memory.h"
+
+namespace mcutl::tests::memory
+{
+
+struct access_count
+{
+	uint32_t reads = 0;
+	uint32_t writes = 0;
+	
+	[[nodiscard]] uint32_t total() const noexcept
+	{
+		return reads + writes;
+	}
+	
+	[[nodiscard]] bool operator==(const access_count& other) const noexcept
+	{
+		return reads == other.reads && writes == other.writes;
+	}
+	
+	[[nodiscard]] bool operator!=(const access_count& other) const noexcept
+	{
+		return !(*this == other);
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const access_count& count)
+{
+	return stream << count.reads << " reads, " << count.writes << " writes";
+}
+
+class access_counter : public memory_access_listener
+{
+public:
+	class scope
+	{
+	public:
+		scope(const scope&) = delete;
+		scope& operator=(const scope&) = delete;
+		
+		scope(access_counter& counter, std::string name)
+			: counter_(counter)
+		{
+			counter_.scopes_.push_back(std::move(name));
+			counter_.per_scope_[counter_.scopes_.back()];
+		}
+		
+		~scope()
+		{
+			counter_.scopes_.pop_back();
+		}
+	
+	private:
+		access_counter& counter_;
+	};
+
+public:
+	access_counter(const access_counter&) = delete;
+	access_counter& operator=(const access_counter&) = delete;
+	
+	access_counter()
+	{
+		memory_controller::add_listener(this);
+	}
+	
+	virtual ~access_counter() override
+	{
+		memory_controller::remove_listener(this);
+	}
+	
+	virtual void on_read(memory_address_t address, uint64_t) override
+	{
+		++total_.reads;
+		++per_address_[address].reads;
+		for (const auto& name : scopes_)
+			++per_scope_[name].reads;
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t) override
+	{
+		++total_.writes;
+		++per_address_[address].writes;
+		for (const auto& name : scopes_)
+			++per_scope_[name].writes;
+	}
+	
+	[[nodiscard]] access_count get_total() const noexcept
+	{
+		return total_;
+	}
+	
+	[[nodiscard]] access_count get(memory_address_t address) const
+	{
+		auto it = per_address_.find(address);
+		return it == per_address_.cend() ? access_count{} : it->second;
+	}
+	
+	[[nodiscard]] access_count get(const std::string& scope_name) const
+	{
+		auto it = per_scope_.find(scope_name);
+		return it == per_scope_.cend() ? access_count{} : it->second;
+	}
+	
+	void reset() noexcept
+	{
+		total_ = {};
+		per_address_.clear();
+		per_scope_.clear();
+	}
+	
+	template<typename Func>
+	access_count measure(const std::string& scope_name, Func&& func)
+	{
+		auto before = get(scope_name);
+		{
+			scope current_scope(*this, scope_name);
+			std::forward<Func>(func)();
+		}
+		auto after = get(scope_name);
+		return { after.reads - before.reads, after.writes - before.writes };
+	}
+	
+	template<typename Func>
+	::testing::AssertionResult within_budget(const std::string& scope_name,
+		uint32_t max_accesses, Func&& func)
+	{
+		auto count = measure(scope_name, std::forward<Func>(func));
+		if (count.total() <= max_accesses)
+			return ::testing::AssertionSuccess();
+		
+		return ::testing::AssertionFailure() << scope_name << " made "
+			<< count.total() << " bus accesses (" << count << "), budget is " << max_accesses;
+	}
+	
+	void report(std::ostream& stream) const
+	{
+		stream << "Total: " << total_ << '\n';
+		for (const auto& [name, count] : per_scope_)
+			stream << name << ": " << count << '\n';
+		
+		auto flags = stream.flags();
+		auto fill = stream.fill();
+		for (const auto& [address, count] : per_address_)
+		{
+			stream << "0x" << std::hex << std::setw(8) << std::setfill('0') << address
+				<< std::dec << ": " << count << '\n';
+		}
+		stream.flags(flags);
+		stream.fill(fill);
+	}
+
+private:
+	access_count total_;
+	std::map<memory_address_t, access_count> per_address_;
+	std::map<std::string, access_count> per_scope_;
+	std::vector<std::string> scopes_;
+};
+
+} //namespace mcutl::tests::memory
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "mcutl/tests/volatile_memory.h"
+
+#ifndef MCUTL_TEST_GOLDEN_DIR
+#	define MCUTL_TEST_GOLDEN_DIR "golden"
+#endif //MCUTL_TEST_GOLDEN_DIR
+
+namespace mcutl::tests::memory
+{
+
+struct access_record
+{
+	memory_address_t address = 0;
+	uint64_t value = 0;
+	bool is_write = false;
+	
+	[[nodiscard]] bool operator==(const access_record& other) const noexcept
+	{
+		return address == other.address && value == other.value && is_write == other.is_write;
+	}
+	
+	[[nodiscard]] bool operator!=(const access_record& other) const noexcept
+	{
+		return !(*this == other);
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& stream, const access_record& record)
+{
+	auto flags = stream.flags();
+	auto fill = stream.fill();
+	stream << (record.is_write ? 'W' : 'R') << std::hex << std::setfill('0')
+		<< " 0x" << std::setw(8) << record.address
+		<< " 0x" << std::setw(8) << record.value;
+	stream.flags(flags);
+	stream.fill(fill);
+	return stream;
+}
+
+[[nodiscard]] inline std::string get_golden_trace_path(const std::string& name)
+{
+	return std::string(MCUTL_TEST_GOLDEN_DIR) + "/" + name + ".trace";
+}
+
+[[nodiscard]] inline bool update_golden_traces_requested() noexcept
+{
+	const char* value = std::getenv("MCUTL_UPDATE_GOLDEN_TRACES");
+	return value && *value && std::string(value) != "0";
+}
+
+class access_trace : public memory_access_listener
+{
+public:
+	access_trace(const access_trace&) = delete;
+	access_trace& operator=(const access_trace&) = delete;
+	
+	access_trace()
+	{
+		memory_controller::add_listener(this);
+	}
+	
+	virtual ~access_trace() override
+	{
+		memory_controller::remove_listener(this);
+	}
+	
+	virtual void on_read(memory_address_t address, uint64_t value) override
+	{
+		records_.push_back({ address, value, false });
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t value) override
+	{
+		records_.push_back({ address, value, true });
+	}
+	
+	[[nodiscard]] const std::vector<access_record>& get_records() const noexcept
+	{
+		return records_;
+	}
+	
+	void clear() noexcept
+	{
+		records_.clear();
+	}
+	
+	void save(std::ostream& stream) const
+	{
+		for (const auto& record : records_)
+			stream << record << '\n';
+	}
+	
+	[[nodiscard]] static std::vector<access_record> load(std::istream& stream)
+	{
+		std::vector<access_record> result;
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			if (line.empty() || line[0] == '#')
+				continue;
+			
+			std::istringstream line_stream(line);
+			char type = 0;
+			access_record record;
+			line_stream >> type >> std::hex >> record.address >> record.value;
+			if (!line_stream || (type != 'R' && type != 'W'))
+				throw std::runtime_error("Invalid access trace line: " + line);
+			
+			record.is_write = type == 'W';
+			result.push_back(record);
+		}
+		return result;
+	}
+	
+	[[nodiscard]] ::testing::AssertionResult matches_golden(const std::string& name) const
+	{
+		auto path = get_golden_trace_path(name);
+		if (update_golden_traces_requested())
+		{
+			std::ofstream file(path);
+			save(file);
+			if (!file)
+				return ::testing::AssertionFailure() << "Unable to write golden trace " << path;
+			return ::testing::AssertionSuccess();
+		}
+		
+		std::ifstream file(path);
+		if (!file)
+		{
+			return ::testing::AssertionFailure() << "Golden trace " << path
+				<< " is absent, set MCUTL_UPDATE_GOLDEN_TRACES=1 to create it";
+		}
+		
+		auto expected = load(file);
+		size_t index = 0;
+		while (index != expected.size() && index != records_.size()
+			&& expected[index] == records_[index])
+		{
+			++index;
+		}
+		
+		if (index == expected.size() && index == records_.size())
+			return ::testing::AssertionSuccess();
+		
+		auto result = ::testing::AssertionFailure();
+		result << "Access trace differs from " << path << " at access #" << index
+			<< " (" << records_.size() << " accesses recorded, "
+			<< expected.size() << " expected)";
+		if (index != expected.size())
+			result << "\nExpected: " << expected[index];
+		if (index != records_.size())
+			result << "\nActual: " << records_[index];
+		return result;
+	}
+
+private:
+	std::vector<access_record> records_;
+};
+
+} //namespace mcutl::tests::memory
@@ -42,4 +42,23 @@ public:
 	}
 };
 
+class flat_test_fixture_base :
+	public instruction::test_fixture_base,
+	public memory::flat_test_fixture_base
+{
+public:
+	virtual void SetUp() override
+	{
+		instruction::test_fixture_base::SetUp();
+		memory::flat_test_fixture_base::SetUp();
+		EXPECT_CALL(instruction(), run).Times(::testing::AtLeast(0));
+	}
+
+	virtual void TearDown() override
+	{
+		memory::flat_test_fixture_base::TearDown();
+		instruction::test_fixture_base::TearDown();
+	}
+};
+
 } //namespace mcutl::tests::mcu
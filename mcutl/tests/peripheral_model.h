@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "mcutl/tests/volatile_memory.h"
+
+namespace mcutl::tests::memory
+{
+
+//Triggers when all bits of the mask are written as ones
+[[nodiscard]] inline auto bits_set(uint64_t mask)
+{
+	return [mask] (uint64_t, uint64_t value) { return (value & mask) == mask; };
+}
+
+//Triggers when all bits of the mask are written as zeros
+[[nodiscard]] inline auto bits_cleared(uint64_t mask)
+{
+	return [mask] (uint64_t, uint64_t value) { return !(value & mask); };
+}
+
+//Triggers when all bits of the mask change from zeros to ones
+[[nodiscard]] inline auto bits_rising(uint64_t mask)
+{
+	return [mask] (uint64_t previous, uint64_t value) {
+		return !(previous & mask) && (value & mask) == mask;
+	};
+}
+
+//Triggers when all bits of the mask change from ones to zeros
+[[nodiscard]] inline auto bits_falling(uint64_t mask)
+{
+	return [mask] (uint64_t previous, uint64_t value) {
+		return (previous & mask) == mask && !(value & mask);
+	};
+}
+
+[[nodiscard]] inline auto any_value()
+{
+	return [] (uint64_t, uint64_t) { return true; };
+}
+
+[[nodiscard]] inline auto set_bits(memory_address_t address, uint64_t mask)
+{
+	return [address, mask] (paged_memory& memory, uint64_t) { memory.get(address) |= mask; };
+}
+
+[[nodiscard]] inline auto clear_bits(memory_address_t address, uint64_t mask)
+{
+	return [address, mask] (paged_memory& memory, uint64_t) { memory.get(address) &= ~mask; };
+}
+
+struct wait_statistics
+{
+	//Count of completed waits
+	uint32_t waits = 0;
+	//Count of reads of the waited register while the wait was pending
+	uint32_t polls = 0;
+};
+
+class peripheral_model : public memory_access_listener
+{
+public:
+	using trigger_type = std::function<bool(uint64_t previous_value, uint64_t written_value)>;
+	using action_type = std::function<void(paged_memory& memory, uint64_t written_value)>;
+
+public:
+	peripheral_model(const peripheral_model&) = delete;
+	peripheral_model& operator=(const peripheral_model&) = delete;
+	
+	explicit peripheral_model(memory_interface_mock& mock)
+		: mock_(mock)
+	{
+		memory_controller::add_listener(this);
+	}
+	
+	virtual ~peripheral_model() override
+	{
+		memory_controller::remove_listener(this);
+	}
+	
+	void add_rule(std::string name, memory_address_t trigger_address, trigger_type trigger,
+		memory_address_t wait_address, uint32_t delay, action_type action)
+	{
+		if (!name.empty())
+			statistics_[name];
+		rules_.push_back({ std::move(name), trigger_address, std::move(trigger),
+			wait_address, delay, std::move(action) });
+	}
+	
+	[[nodiscard]] wait_statistics get_wait_statistics(const std::string& name) const
+	{
+		auto it = statistics_.find(name);
+		return it == statistics_.cend() ? wait_statistics{} : it->second;
+	}
+	
+	void report(std::ostream& stream) const
+	{
+		for (const auto& [name, stats] : statistics_)
+			stream << name << ": " << stats.waits << " waits, " << stats.polls << " polls\n";
+	}
+	
+	[[nodiscard]] paged_memory& storage() noexcept
+	{
+		return mock_.storage();
+	}
+	
+	virtual void before_read(memory_address_t address) override
+	{
+		for (auto it = pending_.begin(); it != pending_.end();)
+		{
+			if (it->rule->wait_address != address)
+			{
+				++it;
+				continue;
+			}
+			
+			auto* stats = it->rule->name.empty() ? nullptr : &statistics_[it->rule->name];
+			if (stats)
+				++stats->polls;
+			if (it->remaining_reads)
+			{
+				--it->remaining_reads;
+				++it;
+				continue;
+			}
+			
+			if (stats)
+				++stats->waits;
+			it->rule->action(storage(), it->written_value);
+			it = pending_.erase(it);
+		}
+	}
+	
+	virtual void on_read(memory_address_t, uint64_t) override
+	{
+	}
+	
+	virtual void before_write(memory_address_t address, uint64_t) override
+	{
+		previous_value_ = storage().get(address);
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t value) override
+	{
+		for (const auto& rule : rules_)
+		{
+			if (rule.trigger_address != address || !rule.trigger(previous_value_, value))
+				continue;
+			
+			//Side effects without a delay are visible right after the write,
+			//not only after the next read of the waited register
+			if (!rule.delay)
+			{
+				if (!rule.name.empty())
+					++statistics_[rule.name].waits;
+				rule.action(storage(), value);
+				continue;
+			}
+			
+			pending_.erase(std::remove_if(pending_.begin(), pending_.end(),
+				[&rule] (const pending_action& action) { return action.rule == &rule; }),
+				pending_.end());
+			pending_.push_back({ &rule, value, rule.delay });
+		}
+	}
+
+private:
+	struct rule_type
+	{
+		std::string name;
+		memory_address_t trigger_address;
+		trigger_type trigger;
+		memory_address_t wait_address;
+		uint32_t delay;
+		action_type action;
+	};
+	
+	struct pending_action
+	{
+		const rule_type* rule;
+		uint64_t written_value;
+		uint32_t remaining_reads;
+	};
+
+private:
+	memory_interface_mock& mock_;
+	std::deque<rule_type> rules_;
+	std::vector<pending_action> pending_;
+	std::map<std::string, wait_statistics> statistics_;
+	uint64_t previous_value_ = 0;
+};
+
+} //namespace mcutl::tests::memory
@@ -0,0 +1,459 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <stddef.h>
+#include <stdint.h>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include "mcutl/tests/instruction.h"
+#include "mcutl/tests/volatile_memory.h"
+
+namespace mcutl::tests::simulation
+{
+
+using cycle_type = uint64_t;
+using irqn_type = int32_t;
+using memory::memory_address_t;
+
+[[maybe_unused]] constexpr cycle_type no_event = (std::numeric_limits<cycle_type>::max)();
+
+struct simulator_config
+{
+	//Core cycles per peripheral memory access
+	cycle_type cycles_per_access = 2;
+	//Core cycles per MCU-specific instruction
+	cycle_type cycles_per_instruction = 1;
+	//Maximum cycles to sleep in a wait-for-interrupt instruction
+	cycle_type max_sleep_cycles = 1'000'000'000;
+};
+
+class simulator;
+
+//Peripheral driven by the virtual cycle clock
+class simulated_device
+{
+public:
+	simulated_device(const simulated_device&) = delete;
+	simulated_device& operator=(const simulated_device&) = delete;
+	
+	explicit simulated_device(simulator& sim);
+	virtual ~simulated_device();
+
+public:
+	//Returns the count of cycles until the next event of the device
+	//(counter overflow, transfer completion, etc.), or no_event.
+	[[nodiscard]] virtual cycle_type get_cycles_to_next_event() const
+	{
+		return no_event;
+	}
+	
+	virtual void advance(cycle_type cycles) = 0;
+	virtual void on_read(memory_address_t, uint64_t) {}
+	virtual void on_write(memory_address_t, uint64_t /* previous_value */, uint64_t /* value */) {}
+	
+	[[nodiscard]] simulator& get_simulator() noexcept
+	{
+		return sim_;
+	}
+	
+	[[nodiscard]] const simulator& get_simulator() const noexcept
+	{
+		return sim_;
+	}
+	
+	[[nodiscard]] memory::paged_memory& storage() noexcept;
+	[[nodiscard]] const memory::paged_memory& storage() const noexcept;
+
+private:
+	simulator& sim_;
+};
+
+//Interrupt controller model used by the simulator to dispatch interrupts
+class interrupt_controller
+{
+public:
+	virtual ~interrupt_controller() {}
+
+public:
+	virtual void set_pending(irqn_type irqn) = 0;
+	//Returns true if the interrupt is both pending and enabled
+	[[nodiscard]] virtual bool is_ready(irqn_type irqn) const = 0;
+	//Returns true if any interrupt is both pending and enabled
+	[[nodiscard]] virtual bool has_ready() const = 0;
+	virtual void enter(irqn_type irqn) = 0;
+	virtual void leave(irqn_type irqn) = 0;
+};
+
+class simulator : public memory::memory_access_listener
+{
+public:
+	using handler_type = std::function<void()>;
+	using source_type = std::function<uint64_t()>;
+	using sink_type = std::function<void(uint64_t value)>;
+
+public:
+	simulator(const simulator&) = delete;
+	simulator& operator=(const simulator&) = delete;
+	
+	simulator(memory::memory_interface_mock& memory,
+		instruction::instruction_interface_mock& instruction,
+		const simulator_config& config = {})
+		: memory_(memory)
+		, instruction_(instruction)
+		, config_(config)
+	{
+		memory::memory_controller::add_listener(this);
+		ON_CALL(instruction_, run).WillByDefault(
+			[this] (std::type_index type, const instruction::instruction_args_type&) {
+				on_instruction(type);
+				return instruction::instruction_return_type {};
+			});
+	}
+	
+	virtual ~simulator() override
+	{
+		instruction_.initialize_default_behavior();
+		memory::memory_controller::remove_listener(this);
+	}
+	
+	[[nodiscard]] cycle_type get_cycles() const noexcept
+	{
+		return cycles_;
+	}
+	
+	[[nodiscard]] const simulator_config& get_config() const noexcept
+	{
+		return config_;
+	}
+	
+	[[nodiscard]] memory::paged_memory& storage() noexcept
+	{
+		return memory_.storage();
+	}
+	
+	[[nodiscard]] const memory::paged_memory& storage() const noexcept
+	{
+		return memory_.storage();
+	}
+	
+	//Advances the virtual clock, stepping through device events
+	//and dispatching interrupts.
+	void advance(cycle_type cycles)
+	{
+		advance_devices(cycles);
+	}
+	
+	//Returns the count of cycles spent by func.
+	template<typename Func>
+	cycle_type measure(Func&& func)
+	{
+		auto start = cycles_;
+		std::forward<Func>(func)();
+		return cycles_ - start;
+	}
+	
+	//Advances the virtual clock until an enabled interrupt becomes pending
+	//or an interrupt handler is called.
+	void sleep()
+	{
+		cycle_type slept = 0;
+		auto dispatched = dispatched_count_;
+		while ((!controller_ || !controller_->has_ready()) && dispatched == dispatched_count_)
+		{
+			if (slept >= config_.max_sleep_cycles)
+				throw std::runtime_error("Simulated MCU sleeps forever: no wakeup event");
+			
+			auto step = (std::min)(get_cycles_to_next_event(), config_.max_sleep_cycles - slept);
+			advance_devices(step);
+			slept += step;
+		}
+		dispatch_interrupts();
+	}
+	
+	void set_interrupt_controller(interrupt_controller* controller) noexcept
+	{
+		controller_ = controller;
+	}
+	
+	void set_pending(irqn_type irqn)
+	{
+		if (controller_)
+			controller_->set_pending(irqn);
+	}
+	
+	void set_handler(irqn_type irqn, handler_type handler)
+	{
+		handlers_[irqn] = std::move(handler);
+	}
+	
+	template<typename Interrupt>
+	void set_handler(handler_type handler)
+	{
+		set_handler(Interrupt::irqn, std::move(handler));
+	}
+	
+	[[nodiscard]] uint32_t get_interrupt_count(irqn_type irqn) const
+	{
+		auto it = interrupt_counts_.find(irqn);
+		return it == interrupt_counts_.cend() ? 0u : it->second;
+	}
+	
+	template<typename Interrupt>
+	[[nodiscard]] uint32_t get_interrupt_count() const
+	{
+		return get_interrupt_count(Interrupt::irqn);
+	}
+	
+	//Instruction which puts the core to sleep until an interrupt (WFI, WFE)
+	void add_sleep_instruction(std::type_index type)
+	{
+		sleep_instructions_.push_back(type);
+	}
+	
+	//Instructions which mask and unmask interrupts (CPSID I, CPSIE I)
+	void set_interrupt_mask_instructions(std::type_index disable, std::type_index enable)
+	{
+		mask_instructions_.emplace_back(disable, true);
+		mask_instructions_.emplace_back(enable, false);
+	}
+	
+	//Makes the host buffer accessible to bus masters (DMA) by its 32-bit address.
+	void map_buffer(const volatile void* data, size_t size)
+	{
+		buffers_.push_back({ const_cast<uint8_t*>(static_cast<const volatile uint8_t*>(data)), size });
+	}
+	
+	void unmap_buffer(const volatile void* data)
+	{
+		buffers_.erase(std::remove_if(buffers_.begin(), buffers_.end(),
+			[data] (const host_buffer& buffer) {
+				return static_cast<const volatile void*>(buffer.data) == data;
+			}),
+			buffers_.end());
+	}
+	
+	//Provides values read by bus masters from the peripheral register (e.g. ADC DR).
+	void set_peripheral_source(memory_address_t address, source_type source)
+	{
+		sources_[address] = std::move(source);
+	}
+	
+	//Receives values written by bus masters to the peripheral register (e.g. SPI DR).
+	void set_peripheral_sink(memory_address_t address, sink_type sink)
+	{
+		sinks_[address] = std::move(sink);
+	}
+	
+	//Bus master read of size bytes at the 32-bit address
+	[[nodiscard]] uint64_t bus_read(uint32_t address, uint32_t size)
+	{
+		if (auto* data = find_buffer(address, size))
+		{
+			uint64_t value = 0;
+			std::memcpy(&value, data, size);
+			return value;
+		}
+		
+		if (auto it = sources_.find(address); it != sources_.end())
+			return it->second();
+		
+		return storage().get(address) & get_size_mask(size);
+	}
+	
+	//Bus master write of size bytes at the 32-bit address
+	void bus_write(uint32_t address, uint32_t size, uint64_t value)
+	{
+		value &= get_size_mask(size);
+		if (auto* data = find_buffer(address, size))
+		{
+			std::memcpy(data, &value, size);
+			return;
+		}
+		
+		if (auto it = sinks_.find(address); it != sinks_.end())
+		{
+			it->second(value);
+			return;
+		}
+		
+		storage().get(address) = value;
+	}
+	
+	void add_device(simulated_device* device)
+	{
+		devices_.push_back(device);
+	}
+	
+	void remove_device(simulated_device* device)
+	{
+		devices_.erase(std::remove(devices_.begin(), devices_.end(), device),
+			devices_.end());
+	}
+	
+	virtual void before_read(memory_address_t) override
+	{
+		advance(config_.cycles_per_access);
+	}
+	
+	virtual void on_read(memory_address_t address, uint64_t value) override
+	{
+		for (auto* device : devices_)
+			device->on_read(address, value);
+	}
+	
+	virtual void before_write(memory_address_t address, uint64_t) override
+	{
+		advance(config_.cycles_per_access);
+		previous_value_ = storage().get(address);
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t value) override
+	{
+		for (auto* device : devices_)
+			device->on_write(address, previous_value_, value);
+		dispatch_interrupts();
+	}
+
+private:
+	struct host_buffer
+	{
+		uint8_t* data;
+		size_t size;
+	};
+
+private:
+	[[nodiscard]] static uint64_t get_size_mask(uint32_t size) noexcept
+	{
+		return size >= sizeof(uint64_t) ? ~uint64_t{} : (uint64_t{1} << (size * 8u)) - 1u;
+	}
+	
+	[[nodiscard]] uint8_t* find_buffer(uint32_t address, uint32_t size) const noexcept
+	{
+		for (const auto& buffer : buffers_)
+		{
+			auto base = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(buffer.data));
+			uint32_t offset = address - base;
+			if (offset < buffer.size && buffer.size - offset >= size)
+				return buffer.data + offset;
+		}
+		return nullptr;
+	}
+	
+	[[nodiscard]] cycle_type get_cycles_to_next_event() const
+	{
+		cycle_type result = no_event;
+		for (const auto* device : devices_)
+			result = (std::min)(result, device->get_cycles_to_next_event());
+		return (std::max)(result, cycle_type{1});
+	}
+	
+	void advance_devices(cycle_type cycles)
+	{
+		while (cycles)
+		{
+			auto step = (std::min)(cycles, get_cycles_to_next_event());
+			for (auto* device : devices_)
+				device->advance(step);
+			cycles_ += step;
+			cycles -= step;
+			dispatch_interrupts();
+		}
+	}
+	
+	void dispatch_interrupts()
+	{
+		if (!controller_ || in_handler_ || masked_)
+			return;
+		
+		bool dispatched = true;
+		while (dispatched)
+		{
+			dispatched = false;
+			for (auto& [irqn, handler] : handlers_)
+			{
+				if (!controller_->is_ready(irqn))
+					continue;
+				
+				in_handler_ = true;
+				controller_->enter(irqn);
+				++interrupt_counts_[irqn];
+				++dispatched_count_;
+				handler();
+				controller_->leave(irqn);
+				in_handler_ = false;
+				dispatched = true;
+				break;
+			}
+		}
+	}
+	
+	void on_instruction(std::type_index type)
+	{
+		advance(config_.cycles_per_instruction);
+		
+		for (const auto& [instruction_type, masks] : mask_instructions_)
+		{
+			if (instruction_type == type)
+			{
+				masked_ = masks;
+				dispatch_interrupts();
+				return;
+			}
+		}
+		
+		if (std::find(sleep_instructions_.cbegin(), sleep_instructions_.cend(), type)
+			!= sleep_instructions_.cend())
+		{
+			sleep();
+		}
+	}
+
+private:
+	memory::memory_interface_mock& memory_;
+	instruction::instruction_interface_mock& instruction_;
+	simulator_config config_;
+	cycle_type cycles_ = 0;
+	uint64_t dispatched_count_ = 0;
+	uint64_t previous_value_ = 0;
+	std::vector<simulated_device*> devices_;
+	interrupt_controller* controller_ = nullptr;
+	std::map<irqn_type, handler_type> handlers_;
+	std::map<irqn_type, uint32_t> interrupt_counts_;
+	std::vector<std::type_index> sleep_instructions_;
+	std::vector<std::pair<std::type_index, bool>> mask_instructions_;
+	std::vector<host_buffer> buffers_;
+	std::map<memory_address_t, source_type> sources_;
+	std::map<memory_address_t, sink_type> sinks_;
+	bool in_handler_ = false;
+	bool masked_ = false;
+};
+
+inline simulated_device::simulated_device(simulator& sim)
+	: sim_(sim)
+{
+	sim_.add_device(this);
+}
+
+inline simulated_device::~simulated_device()
+{
+	sim_.remove_device(this);
+}
+
+inline memory::paged_memory& simulated_device::storage() noexcept
+{
+	return sim_.storage();
+}
+
+inline const memory::paged_memory& simulated_device::storage() const noexcept
+{
+	return sim_.storage();
+}
+
+} //namespace mcutl::tests::simulation
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+
+#include "mcutl/device/device.h"
+#include "mcutl/tests/peripheral_model.h"
+#include "mcutl/tests/volatile_memory.h"
+
+namespace mcutl::tests::memory::stm32f1
+{
+
+[[maybe_unused]] constexpr uint32_t default_model_delay = 2;
+
+template<typename Pointer>
+[[nodiscard]] memory_address_t reg_addr(const volatile Pointer* pointer) noexcept
+{
+	return reinterpret_cast<memory_address_t>(pointer);
+}
+
+//Models RCC oscillator ready flags (HSIRDY, HSERDY, PLLRDY, LSIRDY, LSERDY),
+//system clock switch status (SWS), backup domain reset (BDRST) and clock security
+//system interrupt flag clearing (CSSC).
+class rcc_model : public peripheral_model
+{
+public:
+	explicit rcc_model(memory_interface_mock& mock, uint32_t delay = default_model_delay)
+		: peripheral_model(mock)
+	{
+		add_ready_flag("RCC HSIRDY", reg_addr(&RCC->CR), RCC_CR_HSION, RCC_CR_HSIRDY, delay);
+		add_ready_flag("RCC HSERDY", reg_addr(&RCC->CR), RCC_CR_HSEON, RCC_CR_HSERDY, delay);
+		add_ready_flag("RCC PLLRDY", reg_addr(&RCC->CR), RCC_CR_PLLON, RCC_CR_PLLRDY, delay);
+		add_ready_flag("RCC LSIRDY", reg_addr(&RCC->CSR), RCC_CSR_LSION, RCC_CSR_LSIRDY, delay);
+		add_ready_flag("RCC LSERDY", reg_addr(&RCC->BDCR), RCC_BDCR_LSEON, RCC_BDCR_LSERDY, delay);
+		
+		add_rule("RCC SWS", reg_addr(&RCC->CFGR),
+			[] (uint64_t previous, uint64_t value) { return ((previous ^ value) & RCC_CFGR_SW) != 0; },
+			reg_addr(&RCC->CFGR), delay,
+			[address = reg_addr(&RCC->CFGR)] (paged_memory& memory, uint64_t) {
+				auto& cfgr = memory.get(address);
+				cfgr = (cfgr & ~static_cast<uint64_t>(RCC_CFGR_SWS))
+					| ((cfgr & RCC_CFGR_SW) << RCC_CFGR_SWS_Pos);
+			});
+		
+		add_rule("RCC BDRST", reg_addr(&RCC->BDCR), bits_set(RCC_BDCR_BDRST),
+			reg_addr(&RCC->BDCR), delay, clear_bits(reg_addr(&RCC->BDCR), RCC_BDCR_BDRST));
+		
+		auto cir = reg_addr(&RCC->CIR);
+		add_rule({}, cir, bits_set(RCC_CIR_CSSC), cir, 0, clear_bits(cir, RCC_CIR_CSSF | RCC_CIR_CSSC));
+	}
+
+private:
+	void add_ready_flag(const std::string& name, memory_address_t address,
+		uint32_t enable_bit, uint32_t ready_bit, uint32_t delay)
+	{
+		add_rule(name, address, bits_rising(enable_bit), address, delay,
+			set_bits(address, ready_bit));
+		add_rule(name + " off", address, bits_falling(enable_bit), address, delay,
+			clear_bits(address, ready_bit));
+	}
+};
+
+//Models RTC CRL RTOFF (write operation in progress) and RSF (registers synchronized) flags.
+class rtc_model : public peripheral_model
+{
+public:
+	explicit rtc_model(memory_interface_mock& mock, uint32_t delay = default_model_delay)
+		: peripheral_model(mock)
+	{
+		auto crl = reg_addr(&RTC->CRL);
+		storage().get(crl) |= RTC_CRL_RTOFF;
+		
+		add_rule({}, crl, any_value(), crl, 0, clear_bits(crl, RTC_CRL_RTOFF));
+		add_rule("RTC RTOFF", crl, any_value(), crl, delay, set_bits(crl, RTC_CRL_RTOFF));
+		add_rule("RTC RSF", crl, bits_cleared(RTC_CRL_RSF), crl, delay, set_bits(crl, RTC_CRL_RSF));
+	}
+};
+
+//Models DMA transfer completion: when a channel is enabled, CNDTR becomes zero
+//and TCIF/GIF flags are set after the delay. IFCR writes clear ISR flags.
+class dma_model : public peripheral_model
+{
+public:
+	explicit dma_model(memory_interface_mock& mock, uint32_t delay = default_model_delay)
+		: peripheral_model(mock)
+	{
+		add_dma("DMA1", DMA1, DMA1_Channel1_BASE, 7, delay);
+#ifdef DMA2
+		add_dma("DMA2", DMA2, DMA2_Channel1_BASE, 5, delay);
+#endif //DMA2
+	}
+
+private:
+	void add_dma(const std::string& name, const volatile DMA_TypeDef* dma,
+		uintptr_t channel1_base, uint32_t channel_count, uint32_t delay)
+	{
+		auto isr = reg_addr(&dma->ISR);
+		add_rule({}, reg_addr(&dma->IFCR), any_value(), isr, 0,
+			[isr] (paged_memory& memory, uint64_t value) { memory.get(isr) &= ~value; });
+		
+		constexpr uint32_t channel_offset = DMA1_Channel2_BASE - DMA1_Channel1_BASE;
+		for (uint32_t channel = 0; channel != channel_count; ++channel)
+		{
+			auto* channel_reg = reinterpret_cast<const volatile DMA_Channel_TypeDef*>(
+				channel1_base + channel * channel_offset);
+			auto cndtr = reg_addr(&channel_reg->CNDTR);
+			uint64_t flags = static_cast<uint64_t>(DMA_ISR_GIF1 | DMA_ISR_TCIF1)
+				<< (channel * DMA_ISR_GIF2_Pos);
+			add_rule(name + " channel " + std::to_string(channel + 1),
+				reg_addr(&channel_reg->CCR), bits_rising(DMA_CCR_EN), cndtr, delay,
+				[cndtr, isr, flags] (paged_memory& memory, uint64_t ccr) {
+					if (!(ccr & DMA_CCR_CIRC))
+						memory.get(cndtr) = 0;
+					memory.get(isr) |= flags;
+				});
+		}
+	}
+};
+
+//Models ADC calibration (CAL, RSTCAL) and software-started conversion (EOC, JEOC) flags.
+class adc_model : public peripheral_model
+{
+public:
+	explicit adc_model(memory_interface_mock& mock, uint32_t delay = default_model_delay)
+		: peripheral_model(mock)
+	{
+		add_adc("ADC1", ADC1, delay);
+#ifdef ADC2
+		add_adc("ADC2", ADC2, delay);
+#endif //ADC2
+#ifdef ADC3
+		add_adc("ADC3", ADC3, delay);
+#endif //ADC3
+	}
+
+private:
+	void add_adc(const std::string& name, const volatile ADC_TypeDef* adc, uint32_t delay)
+	{
+		auto cr2 = reg_addr(&adc->CR2);
+		auto sr = reg_addr(&adc->SR);
+		add_rule(name + " CAL", cr2, bits_set(ADC_CR2_CAL), cr2, delay,
+			clear_bits(cr2, ADC_CR2_CAL));
+		add_rule(name + " RSTCAL", cr2, bits_set(ADC_CR2_RSTCAL), cr2, delay,
+			clear_bits(cr2, ADC_CR2_RSTCAL));
+		add_rule(name + " EOC", cr2, bits_set(ADC_CR2_SWSTART), sr, delay,
+			[cr2, sr] (paged_memory& memory, uint64_t) {
+				memory.get(cr2) &= ~static_cast<uint64_t>(ADC_CR2_SWSTART);
+				memory.get(sr) |= ADC_SR_EOC;
+			});
+		add_rule(name + " JEOC", cr2, bits_set(ADC_CR2_JSWSTART), sr, delay,
+			[cr2, sr] (paged_memory& memory, uint64_t) {
+				memory.get(cr2) &= ~static_cast<uint64_t>(ADC_CR2_JSWSTART);
+				memory.get(sr) |= ADC_SR_JEOC;
+			});
+	}
+};
+
+//Models SPI SR TXE, RXNE and BSY flags: a DR write clears TXE and sets BSY,
+//and after the delay TXE and RXNE are set and BSY is cleared.
+class spi_model : public peripheral_model
+{
+public:
+	explicit spi_model(memory_interface_mock& mock, uint32_t delay = default_model_delay)
+		: peripheral_model(mock)
+	{
+		add_spi("SPI1", SPI1, delay);
+#ifdef SPI2
+		add_spi("SPI2", SPI2, delay);
+#endif //SPI2
+#ifdef SPI3
+		add_spi("SPI3", SPI3, delay);
+#endif //SPI3
+	}
+
+private:
+	void add_spi(const std::string& name, const volatile SPI_TypeDef* spi, uint32_t delay)
+	{
+		auto dr = reg_addr(&spi->DR);
+		auto sr = reg_addr(&spi->SR);
+		storage().get(sr) |= SPI_SR_TXE;
+		
+		add_rule({}, dr, any_value(), sr, 0,
+			[sr] (paged_memory& memory, uint64_t) {
+				auto& value = memory.get(sr);
+				value = (value & ~static_cast<uint64_t>(SPI_SR_TXE)) | SPI_SR_BSY;
+			});
+		add_rule(name + " TXE", dr, any_value(), sr, delay,
+			[sr] (paged_memory& memory, uint64_t) {
+				auto& value = memory.get(sr);
+				value = (value & ~static_cast<uint64_t>(SPI_SR_BSY)) | SPI_SR_TXE | SPI_SR_RXNE;
+			});
+	}
+};
+
+} //namespace mcutl::tests::memory::stm32f1
@@ -0,0 +1,673 @@
+#pragma once
+
+#include <array>
+#include <deque>
+#include <stdexcept>
+#include <stdint.h>
+#include <typeinfo>
+#include <vector>
+
+#include "mcutl/device/device.h"
+#include "mcutl/instruction/instruction.h"
+#include "mcutl/tests/simulator.h"
+
+namespace mcutl::tests::simulation::stm32f1
+{
+
+template<typename Pointer>
+[[nodiscard]] memory_address_t reg_addr(const volatile Pointer* pointer) noexcept
+{
+	return reinterpret_cast<memory_address_t>(pointer);
+}
+
+//Models NVIC ISER/ICER/ISPR/ICPR set and clear semantics, SysTick pending flag
+//and the active vector in SCB ICSR.
+class nvic_device : public simulated_device, public interrupt_controller
+{
+public:
+	explicit nvic_device(simulator& sim)
+		: simulated_device(sim)
+	{
+		sim.set_interrupt_controller(this);
+	}
+	
+	virtual ~nvic_device() override
+	{
+		get_simulator().set_interrupt_controller(nullptr);
+	}
+	
+	virtual void advance(cycle_type) override
+	{
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t, uint64_t value) override
+	{
+		for (uint32_t i = 0; i != register_count; ++i)
+		{
+			if (address == reg_addr(&NVIC->ISER[i]))
+				enabled_[i] |= static_cast<uint32_t>(value);
+			else if (address == reg_addr(&NVIC->ICER[i]))
+				enabled_[i] &= ~static_cast<uint32_t>(value);
+			else if (address == reg_addr(&NVIC->ISPR[i]))
+				pending_[i] |= static_cast<uint32_t>(value);
+			else if (address == reg_addr(&NVIC->ICPR[i]))
+				pending_[i] &= ~static_cast<uint32_t>(value);
+			else
+				continue;
+			
+			sync(i);
+			return;
+		}
+		
+		if (address == reg_addr(&SCB->ICSR))
+		{
+			if (value & SCB_ICSR_PENDSTSET_Msk)
+				systick_pending_ = true;
+			if (value & SCB_ICSR_PENDSTCLR_Msk)
+				systick_pending_ = false;
+			sync_icsr();
+		}
+	}
+	
+	virtual void set_pending(irqn_type irqn) override
+	{
+		if (irqn == SysTick_IRQn)
+		{
+			systick_pending_ = true;
+			sync_icsr();
+		}
+		else if (irqn >= 0)
+		{
+			pending_[irqn >> 5u] |= get_mask(irqn);
+			sync(irqn >> 5u);
+		}
+	}
+	
+	[[nodiscard]] virtual bool is_ready(irqn_type irqn) const override
+	{
+		if (irqn == SysTick_IRQn)
+			return systick_pending_;
+		if (irqn < 0)
+			return false;
+		return (pending_[irqn >> 5u] & enabled_[irqn >> 5u] & get_mask(irqn)) != 0;
+	}
+	
+	[[nodiscard]] virtual bool has_ready() const override
+	{
+		if (systick_pending_)
+			return true;
+		for (uint32_t i = 0; i != register_count; ++i)
+		{
+			if (pending_[i] & enabled_[i])
+				return true;
+		}
+		return false;
+	}
+	
+	virtual void enter(irqn_type irqn) override
+	{
+		if (irqn == SysTick_IRQn)
+		{
+			systick_pending_ = false;
+		}
+		else if (irqn >= 0)
+		{
+			pending_[irqn >> 5u] &= ~get_mask(irqn);
+			sync(irqn >> 5u);
+		}
+		active_vector_ = static_cast<uint32_t>(irqn + 16);
+		sync_icsr();
+	}
+	
+	virtual void leave(irqn_type) override
+	{
+		active_vector_ = 0;
+		sync_icsr();
+	}
+
+private:
+	static constexpr uint32_t register_count = 8;
+
+private:
+	[[nodiscard]] static uint32_t get_mask(irqn_type irqn) noexcept
+	{
+		return 1u << (static_cast<uint32_t>(irqn) & 0x1fu);
+	}
+	
+	void sync(uint32_t index)
+	{
+		storage().get(reg_addr(&NVIC->ISER[index])) = enabled_[index];
+		storage().get(reg_addr(&NVIC->ICER[index])) = enabled_[index];
+		storage().get(reg_addr(&NVIC->ISPR[index])) = pending_[index];
+		storage().get(reg_addr(&NVIC->ICPR[index])) = pending_[index];
+	}
+	
+	void sync_icsr()
+	{
+		storage().get(reg_addr(&SCB->ICSR)) = (systick_pending_ ? SCB_ICSR_PENDSTSET_Msk : 0u)
+			| (active_vector_ & SCB_ICSR_VECTACTIVE_Msk);
+	}
+
+private:
+	std::array<uint32_t, register_count> enabled_ {};
+	std::array<uint32_t, register_count> pending_ {};
+	bool systick_pending_ = false;
+	uint32_t active_vector_ = 0;
+};
+
+//Models the SysTick down counter, COUNTFLAG (cleared on CTRL read and VAL write)
+//and the tick interrupt.
+class systick_device : public simulated_device
+{
+public:
+	using simulated_device::simulated_device;
+	
+	[[nodiscard]] virtual cycle_type get_cycles_to_next_event() const override
+	{
+		auto ctrl = get_reg(&SysTick->CTRL);
+		if (!(ctrl & SysTick_CTRL_ENABLE_Msk))
+			return no_event;
+		
+		auto value = get_reg(&SysTick->VAL) & SysTick_VAL_CURRENT_Msk;
+		auto load = get_reg(&SysTick->LOAD) & SysTick_LOAD_RELOAD_Msk;
+		if (!value && !load)
+			return no_event;
+		
+		cycle_type ticks = value ? value : load + 1u;
+		return ticks * get_divider(ctrl) - prescaler_;
+	}
+	
+	virtual void advance(cycle_type cycles) override
+	{
+		auto& ctrl = storage().get(reg_addr(&SysTick->CTRL));
+		if (!(ctrl & SysTick_CTRL_ENABLE_Msk))
+			return;
+		
+		auto divider = get_divider(ctrl);
+		cycle_type ticks = (prescaler_ + cycles) / divider;
+		prescaler_ = (prescaler_ + cycles) % divider;
+		
+		auto& value = storage().get(reg_addr(&SysTick->VAL));
+		value &= SysTick_VAL_CURRENT_Msk;
+		auto load = storage().get(reg_addr(&SysTick->LOAD)) & SysTick_LOAD_RELOAD_Msk;
+		while (ticks)
+		{
+			if (!value)
+			{
+				if (!load)
+					break;
+				
+				value = load;
+				--ticks;
+				continue;
+			}
+			
+			auto step = (std::min)(ticks, static_cast<cycle_type>(value));
+			value -= step;
+			ticks -= step;
+			if (!value)
+			{
+				ctrl |= SysTick_CTRL_COUNTFLAG_Msk;
+				if (ctrl & SysTick_CTRL_TICKINT_Msk)
+					get_simulator().set_pending(SysTick_IRQn);
+			}
+		}
+	}
+	
+	virtual void on_read(memory_address_t address, uint64_t) override
+	{
+		if (address == reg_addr(&SysTick->CTRL))
+			storage().get(address) &= ~static_cast<uint64_t>(SysTick_CTRL_COUNTFLAG_Msk);
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t previous_value,
+		uint64_t value) override
+	{
+		if (address == reg_addr(&SysTick->CTRL))
+		{
+			storage().get(address) = (value & ~static_cast<uint64_t>(SysTick_CTRL_COUNTFLAG_Msk))
+				| (previous_value & SysTick_CTRL_COUNTFLAG_Msk);
+			if (!(previous_value & SysTick_CTRL_ENABLE_Msk))
+				prescaler_ = 0;
+		}
+		else if (address == reg_addr(&SysTick->VAL))
+		{
+			storage().get(address) = 0;
+			storage().get(reg_addr(&SysTick->CTRL))
+				&= ~static_cast<uint64_t>(SysTick_CTRL_COUNTFLAG_Msk);
+		}
+	}
+
+private:
+	[[nodiscard]] static cycle_type get_divider(uint64_t ctrl) noexcept
+	{
+		return (ctrl & SysTick_CTRL_CLKSOURCE_Msk) ? 1u : 8u;
+	}
+	
+	template<typename Reg>
+	[[nodiscard]] uint64_t get_reg(const volatile Reg* reg) const
+	{
+		return storage().get(reg_addr(reg));
+	}
+
+private:
+	cycle_type prescaler_ = 0;
+};
+
+//Models a timer time base: CNT counting up or down with PSC and ARR
+//(both applied on the update event when buffered), UIF and the update interrupt.
+class timer_device : public simulated_device
+{
+public:
+	timer_device(simulator& sim, const volatile TIM_TypeDef* timer,
+		irqn_type update_irqn, cycle_type clock_divider = 1)
+		: simulated_device(sim)
+		, timer_(timer)
+		, update_irqn_(update_irqn)
+		, clock_divider_(clock_divider)
+	{
+	}
+	
+	[[nodiscard]] const volatile TIM_TypeDef* get_timer() const noexcept
+	{
+		return timer_;
+	}
+	
+	//Sets core cycles per timer kernel clock cycle
+	void set_clock_divider(cycle_type clock_divider) noexcept
+	{
+		clock_divider_ = clock_divider;
+		kernel_prescaler_ = 0;
+	}
+	
+	[[nodiscard]] virtual cycle_type get_cycles_to_next_event() const override
+	{
+		const auto& memory = storage();
+		auto cr1 = memory.get(reg_addr(&timer_->CR1));
+		auto arr = get_auto_reload(memory, cr1);
+		if (!(cr1 & TIM_CR1_CEN) || !arr)
+			return no_event;
+		
+		auto counter = memory.get(reg_addr(&timer_->CNT)) & 0xffffu;
+		cycle_type counts = (cr1 & TIM_CR1_DIR) ? counter + 1u
+			: (counter <= arr ? arr - counter + 1u : 0x10000u - counter);
+		return (counts * (active_prescaler_ + 1u) - prescaler_counter_) * clock_divider_
+			- kernel_prescaler_;
+	}
+	
+	virtual void advance(cycle_type cycles) override
+	{
+		if (!(storage().get(reg_addr(&timer_->CR1)) & TIM_CR1_CEN))
+			return;
+		
+		cycle_type kernel_ticks = (kernel_prescaler_ + cycles) / clock_divider_;
+		kernel_prescaler_ = (kernel_prescaler_ + cycles) % clock_divider_;
+		cycle_type prescaler_ticks = prescaler_counter_ + kernel_ticks;
+		prescaler_counter_ = prescaler_ticks % (active_prescaler_ + 1u);
+		count(prescaler_ticks / (active_prescaler_ + 1u));
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t previous_value,
+		uint64_t value) override
+	{
+		if (address == reg_addr(&timer_->EGR))
+		{
+			storage().get(address) = 0;
+			if (value & TIM_EGR_UG)
+			{
+				auto cr1 = storage().get(reg_addr(&timer_->CR1));
+				prescaler_counter_ = 0;
+				update_event(true);
+				storage().get(reg_addr(&timer_->CNT)) = (cr1 & TIM_CR1_DIR)
+					? get_auto_reload(storage(), cr1) : 0u;
+			}
+		}
+		else if (address == reg_addr(&timer_->SR))
+		{
+			storage().get(address) = previous_value & value;
+		}
+		else if (address == reg_addr(&timer_->ARR))
+		{
+			if (!(storage().get(reg_addr(&timer_->CR1)) & TIM_CR1_ARPE))
+				active_auto_reload_ = value;
+		}
+	}
+
+private:
+	[[nodiscard]] uint64_t get_auto_reload(const memory::paged_memory& memory, uint64_t cr1) const
+	{
+		return ((cr1 & TIM_CR1_ARPE) ? active_auto_reload_
+			: memory.get(reg_addr(&timer_->ARR))) & 0xffffu;
+	}
+	
+	void count(cycle_type counts)
+	{
+		auto& counter = storage().get(reg_addr(&timer_->CNT));
+		counter &= 0xffffu;
+		while (counts)
+		{
+			auto cr1 = storage().get(reg_addr(&timer_->CR1));
+			auto arr = get_auto_reload(storage(), cr1);
+			if (!arr || !(cr1 & TIM_CR1_CEN))
+				return;
+			
+			bool down = (cr1 & TIM_CR1_DIR) != 0;
+			cycle_type to_update = down ? counter + 1u
+				: (counter <= arr ? arr - counter + 1u : 0x10000u - counter);
+			if (counts < to_update)
+			{
+				counter = down ? counter - counts : counter + counts;
+				return;
+			}
+			
+			counts -= to_update;
+			update_event(false);
+			counter = down ? get_auto_reload(storage(), cr1) : 0u;
+			if (cr1 & TIM_CR1_OPM)
+			{
+				storage().get(reg_addr(&timer_->CR1)) &= ~static_cast<uint64_t>(TIM_CR1_CEN);
+				return;
+			}
+		}
+	}
+	
+	void update_event(bool software)
+	{
+		auto cr1 = storage().get(reg_addr(&timer_->CR1));
+		if (!software && (cr1 & TIM_CR1_UDIS))
+			return;
+		
+		active_prescaler_ = storage().get(reg_addr(&timer_->PSC)) & 0xffffu;
+		active_auto_reload_ = storage().get(reg_addr(&timer_->ARR)) & 0xffffu;
+		if (software && (cr1 & TIM_CR1_URS))
+			return;
+		
+		storage().get(reg_addr(&timer_->SR)) |= TIM_SR_UIF;
+		if (storage().get(reg_addr(&timer_->DIER)) & TIM_DIER_UIE)
+			get_simulator().set_pending(update_irqn_);
+	}
+
+private:
+	const volatile TIM_TypeDef* timer_;
+	irqn_type update_irqn_;
+	cycle_type clock_divider_;
+	cycle_type kernel_prescaler_ = 0;
+	cycle_type prescaler_counter_ = 0;
+	uint64_t active_prescaler_ = 0;
+	uint64_t active_auto_reload_ = 0;
+};
+
+//Models DMA channels: each enabled channel transfers one data item per period
+//between mapped host buffers and peripheral registers, decrementing CNDTR
+//and raising HTIF/TCIF flags and interrupts. IFCR writes clear ISR flags.
+class dma_device : public simulated_device
+{
+public:
+	dma_device(simulator& sim, const volatile DMA_TypeDef* dma,
+		uintptr_t channel1_base, std::vector<irqn_type> channel_irqns,
+		cycle_type cycles_per_item = default_cycles_per_item)
+		: simulated_device(sim)
+		, dma_(dma)
+		, channel1_base_(channel1_base)
+		, channel_irqns_(std::move(channel_irqns))
+		, channels_(channel_irqns_.size())
+	{
+		for (auto& channel : channels_)
+			channel.period = cycles_per_item;
+	}
+	
+	//Sets the cycles per data item for the channel (1-based), which
+	//models the rate of peripheral DMA requests.
+	void set_channel_period(uint32_t channel, cycle_type cycles_per_item)
+	{
+		channels_.at(channel - 1u).period = (std::max)(cycles_per_item, cycle_type{1});
+	}
+	
+	[[nodiscard]] virtual cycle_type get_cycles_to_next_event() const override
+	{
+		cycle_type result = no_event;
+		const auto& memory = storage();
+		for (uint32_t index = 0; index != channels_.size(); ++index)
+		{
+			const auto& channel = channels_[index];
+			if (channel.active && memory.get(reg_addr(&get_channel(index)->CNDTR)))
+				result = (std::min)(result, channel.period - channel.prescaler);
+		}
+		return result;
+	}
+	
+	virtual void advance(cycle_type cycles) override
+	{
+		for (uint32_t index = 0; index != channels_.size(); ++index)
+		{
+			auto& channel = channels_[index];
+			if (!channel.active)
+				continue;
+			
+			cycle_type items = (channel.prescaler + cycles) / channel.period;
+			channel.prescaler = (channel.prescaler + cycles) % channel.period;
+			while (items-- && channel.active
+				&& storage().get(reg_addr(&get_channel(index)->CNDTR)))
+			{
+				transfer_item(index);
+			}
+		}
+	}
+	
+	virtual void on_write(memory_address_t address, uint64_t previous_value,
+		uint64_t value) override
+	{
+		if (address == reg_addr(&dma_->IFCR))
+		{
+			storage().get(reg_addr(&dma_->ISR)) &= ~value;
+			storage().get(address) = 0;
+			return;
+		}
+		
+		for (uint32_t index = 0; index != channels_.size(); ++index)
+		{
+			auto* channel_reg = get_channel(index);
+			if (address != reg_addr(&channel_reg->CCR))
+				continue;
+			
+			auto& channel = channels_[index];
+			if ((value & DMA_CCR_EN) && !(previous_value & DMA_CCR_EN))
+			{
+				channel.active = true;
+				channel.total = storage().get(reg_addr(&channel_reg->CNDTR)) & 0xffffu;
+				channel.done = 0;
+				channel.prescaler = 0;
+			}
+			else if (!(value & DMA_CCR_EN))
+			{
+				channel.active = false;
+			}
+			return;
+		}
+	}
+
+private:
+	static constexpr cycle_type default_cycles_per_item = 4;
+	
+	struct channel_state
+	{
+		bool active = false;
+		uint64_t total = 0;
+		uint64_t done = 0;
+		cycle_type period = default_cycles_per_item;
+		cycle_type prescaler = 0;
+	};
+
+private:
+	[[nodiscard]] const volatile DMA_Channel_TypeDef* get_channel(uint32_t index) const noexcept
+	{
+		constexpr uintptr_t channel_offset = DMA1_Channel2_BASE - DMA1_Channel1_BASE;
+		return reinterpret_cast<const volatile DMA_Channel_TypeDef*>(
+			channel1_base_ + index * channel_offset);
+	}
+	
+	[[nodiscard]] static uint32_t get_size(uint64_t ccr, uint32_t mask, uint32_t position) noexcept
+	{
+		return 1u << ((ccr & mask) >> position);
+	}
+	
+	void transfer_item(uint32_t index)
+	{
+		auto* channel_reg = get_channel(index);
+		auto& channel = channels_[index];
+		auto& memory = storage();
+		auto ccr = memory.get(reg_addr(&channel_reg->CCR));
+		
+		auto peripheral_size = get_size(ccr, DMA_CCR_PSIZE, DMA_CCR_PSIZE_Pos);
+		auto memory_size = get_size(ccr, DMA_CCR_MSIZE, DMA_CCR_MSIZE_Pos);
+		auto peripheral_address = static_cast<uint32_t>(memory.get(reg_addr(&channel_reg->CPAR))
+			+ ((ccr & DMA_CCR_PINC) ? channel.done * peripheral_size : 0u));
+		auto memory_address = static_cast<uint32_t>(memory.get(reg_addr(&channel_reg->CMAR))
+			+ ((ccr & DMA_CCR_MINC) ? channel.done * memory_size : 0u));
+		
+		auto& sim = get_simulator();
+		if (ccr & DMA_CCR_DIR) //read from memory
+			sim.bus_write(peripheral_address, peripheral_size, sim.bus_read(memory_address, memory_size));
+		else
+			sim.bus_write(memory_address, memory_size, sim.bus_read(peripheral_address, peripheral_size));
+		
+		++channel.done;
+		auto& remaining = memory.get(reg_addr(&channel_reg->CNDTR));
+		--remaining;
+		
+		auto& isr = memory.get(reg_addr(&dma_->ISR));
+		auto flag_shift = index * DMA_ISR_GIF2_Pos;
+		bool raise_interrupt = false;
+		if (channel.done == channel.total / 2u && channel.total > 1u)
+		{
+			isr |= static_cast<uint64_t>(DMA_ISR_GIF1 | DMA_ISR_HTIF1) << flag_shift;
+			raise_interrupt = (ccr & DMA_CCR_HTIE) != 0;
+		}
+		
+		if (!remaining)
+		{
+			isr |= static_cast<uint64_t>(DMA_ISR_GIF1 | DMA_ISR_TCIF1) << flag_shift;
+			raise_interrupt = raise_interrupt || (ccr & DMA_CCR_TCIE);
+			if (ccr & DMA_CCR_CIRC)
+			{
+				remaining = channel.total;
+				channel.done = 0;
+			}
+		}
+		
+		if (raise_interrupt)
+			sim.set_pending(channel_irqns_[index]);
+	}
+
+private:
+	const volatile DMA_TypeDef* dma_;
+	uintptr_t channel1_base_;
+	std::vector<irqn_type> channel_irqns_;
+	std::vector<channel_state> channels_;
+};
+
+//Simulator with NVIC, SysTick, timer and DMA devices of the current MCU.
+//WFI and WFE instructions sleep until an interrupt, CPSID I and CPSIE I
+//mask and unmask interrupts.
+class mcu_simulator : public simulator
+{
+public:
+	mcu_simulator(memory::memory_interface_mock& memory,
+		instruction::instruction_interface_mock& instruction,
+		const simulator_config& config = {})
+		: simulator(memory, instruction, config)
+		, nvic_(*this)
+		, systick_(*this)
+		, dma1_(*this, DMA1, DMA1_Channel1_BASE, {
+			DMA1_Channel1_IRQn, DMA1_Channel2_IRQn, DMA1_Channel3_IRQn, DMA1_Channel4_IRQn,
+			DMA1_Channel5_IRQn, DMA1_Channel6_IRQn, DMA1_Channel7_IRQn })
+#ifdef DMA2
+#	if defined(STM32F105xC) || defined(STM32F107xC) //Connectivity
+		, dma2_(*this, DMA2, DMA2_Channel1_BASE, {
+			DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn,
+			DMA2_Channel4_IRQn, DMA2_Channel5_IRQn })
+#	else //Connectivity
+		, dma2_(*this, DMA2, DMA2_Channel1_BASE, {
+			DMA2_Channel1_IRQn, DMA2_Channel2_IRQn, DMA2_Channel3_IRQn,
+			DMA2_Channel4_5_IRQn, DMA2_Channel4_5_IRQn })
+#	endif //Connectivity
+#endif //DMA2
+	{
+#ifdef TIM1
+#	if defined(STM32F103xG) || defined(STM32F101xG) //XL-density
+		timers_.emplace_back(*this, TIM1, TIM1_UP_TIM10_IRQn);
+#	else //XL-density
+		timers_.emplace_back(*this, TIM1, TIM1_UP_IRQn);
+#	endif //XL-density
+#endif //TIM1
+		timers_.emplace_back(*this, TIM2, TIM2_IRQn);
+		timers_.emplace_back(*this, TIM3, TIM3_IRQn);
+#ifdef TIM4
+		timers_.emplace_back(*this, TIM4, TIM4_IRQn);
+#endif //TIM4
+#ifdef TIM5
+		timers_.emplace_back(*this, TIM5, TIM5_IRQn);
+#endif //TIM5
+#ifdef TIM6
+		timers_.emplace_back(*this, TIM6, TIM6_IRQn);
+#endif //TIM6
+#ifdef TIM7
+		timers_.emplace_back(*this, TIM7, TIM7_IRQn);
+#endif //TIM7
+#ifdef TIM8
+#	if defined(STM32F103xG) || defined(STM32F101xG) //XL-density
+		timers_.emplace_back(*this, TIM8, TIM8_UP_TIM13_IRQn);
+#	else //XL-density
+		timers_.emplace_back(*this, TIM8, TIM8_UP_IRQn);
+#	endif //XL-density
+#endif //TIM8
+
+		add_sleep_instruction(typeid(mcutl::device::instruction::type::wfi));
+		add_sleep_instruction(typeid(mcutl::device::instruction::type::wfe));
+		set_interrupt_mask_instructions(typeid(mcutl::device::instruction::type::cpsid_i),
+			typeid(mcutl::device::instruction::type::cpsie_i));
+	}
+	
+	[[nodiscard]] nvic_device& nvic() noexcept
+	{
+		return nvic_;
+	}
+	
+	[[nodiscard]] systick_device& systick() noexcept
+	{
+		return systick_;
+	}
+	
+	[[nodiscard]] timer_device& timer(const volatile TIM_TypeDef* timer)
+	{
+		for (auto& device : timers_)
+		{
+			if (device.get_timer() == timer)
+				return device;
+		}
+		throw std::out_of_range("Timer is not simulated");
+	}
+	
+	[[nodiscard]] dma_device& dma1() noexcept
+	{
+		return dma1_;
+	}
+
+#ifdef DMA2
+	[[nodiscard]] dma_device& dma2() noexcept
+	{
+		return dma2_;
+	}
+#endif //DMA2
+
+private:
+	nvic_device nvic_;
+	systick_device systick_;
+	dma_device dma1_;
+#ifdef DMA2
+	dma_device dma2_;
+#endif //DMA2
+	std::deque<timer_device> timers_;
+};
+
+} //namespace mcutl::tests::simulation::stm32f1
@@ -1,10 +1,15 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <limits>
+#include <memory>
 #include <stdint.h>
 #include <type_traits>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -27,6 +32,83 @@ public:
 	virtual uint64_t read(memory_address_t address) = 0;
 };
 
+class paged_memory
+{
+public:
+	static constexpr memory_address_t page_size = 0x400u;
+	
+public:
+	[[nodiscard]] uint64_t get(memory_address_t address) const
+	{
+		const auto* page = find_page(address / page_size);
+		return page ? (*page)[address % page_size] : 0;
+	}
+	
+	[[nodiscard]] uint64_t& get(memory_address_t address)
+	{
+		return get_page(address / page_size)[address % page_size];
+	}
+	
+	void set(memory_address_t address, uint64_t value)
+	{
+		get(address) = value;
+	}
+	
+	void clear() noexcept
+	{
+		pages_.clear();
+		last_page_index_ = no_page;
+		last_page_ = nullptr;
+	}
+	
+private:
+	using page_type = std::array<uint64_t, page_size>;
+	static constexpr memory_address_t no_page = (std::numeric_limits<memory_address_t>::max)();
+	
+	page_type* find_page(memory_address_t page_index) const
+	{
+		if (page_index == last_page_index_)
+			return last_page_;
+		
+		auto it = pages_.find(page_index);
+		if (it == pages_.cend())
+			return nullptr;
+		
+		last_page_index_ = page_index;
+		last_page_ = it->second.get();
+		return last_page_;
+	}
+	
+	page_type& get_page(memory_address_t page_index)
+	{
+		if (auto* page = find_page(page_index); page)
+			return *page;
+		
+		auto& page = pages_[page_index];
+		page = std::make_unique<page_type>();
+		last_page_index_ = page_index;
+		last_page_ = page.get();
+		return *last_page_;
+	}
+	
+private:
+	std::unordered_map<memory_address_t, std::unique_ptr<page_type>> pages_;
+	mutable memory_address_t last_page_index_ = no_page;
+	mutable page_type* last_page_ = nullptr;
+};
+
+class memory_access_listener
+{
+public:
+	virtual ~memory_access_listener() {}
+
+public:
+	virtual void before_read(memory_address_t) {}
+	virtual void before_write(memory_address_t, uint64_t) {}
+	virtual void on_read(memory_address_t address, uint64_t value) = 0;
+	virtual void on_write(memory_address_t address, uint64_t value) = 0;
+};
+
 class memory_interface_mock;
 class memory_interface_not_mocked : public memory_interface
 {
@@ -42,6 +124,7 @@ public:
 	
 private:
 	memory_interface_mock& mock_;
+	memory_interface* previous_interface_;
 };
 
 class memory_interface_mock : public memory_interface
@@ -77,23 +160,28 @@ public:
 		EXPECT_CALL(*this, read(address)).Times(::testing::AtLeast(0));
 	}
 	
+	void allow_all_accesses()
+	{
+		EXPECT_CALL(*this, read).Times(::testing::AtLeast(0));
+		EXPECT_CALL(*this, write).Times(::testing::AtLeast(0));
+	}
+	
 	[[nodiscard]] uint64_t get(memory_address_t address) const
 	{
 		check_same_address_accesses(address);
-		auto it = memory_.find(address);
-		return it == cend(memory_) ? 0 : it->second;
+		return std::as_const(memory_).get(address);
 	}
 	
 	void set(memory_address_t address, uint64_t value)
 	{
 		check_same_address_accesses(address);
-		memory_[address] = value;
+		memory_.set(address, value);
 	}
 	
 	[[nodiscard]] uint64_t& get(memory_address_t address)
 	{
 		check_same_address_accesses(address);
-		return memory_[address];
+		return memory_.get(address);
 	}
 	
 	void set_same_address_access_limit(uint32_t max_same_address_accesses)
@@ -101,6 +189,11 @@ public:
 		max_same_address_accesses_ = max_same_address_accesses;
 	}
 	
+	[[nodiscard]] paged_memory& storage() noexcept
+	{
+		return memory_;
+	}
+	
 	MOCK_METHOD(void, write, (memory_address_t address, uint64_t value), (override));
 	MOCK_METHOD(uint64_t, read, (memory_address_t address), (override));
 	
@@ -125,7 +218,7 @@ private:
 	}
 	
 private:
-	std::unordered_map<memory_address_t, uint64_t> memory_;
+	paged_memory memory_;
 	mutable memory_address_t last_access_address_ = 0;
 	uint32_t max_same_address_accesses_ = 0;
 	mutable uint32_t same_address_accesses_ = 0;
@@ -140,13 +233,33 @@ public:
 		interface_ = instance;
 	}
 	
+	[[nodiscard]] static memory_interface* get_interface() noexcept
+	{
+		return interface_;
+	}
+	
+	static void add_listener(memory_access_listener* listener)
+	{
+		listeners_.push_back(listener);
+	}
+	
+	static void remove_listener(memory_access_listener* listener) noexcept
+	{
+		listeners_.erase(std::remove(listeners_.begin(), listeners_.end(), listener),
+			listeners_.end());
+	}
+	
 public:
 	template<typename Ptr, typename Value>
 	static void write(Ptr* pointer, Value value)
 	{
 		assert(interface_);
 		auto address = reinterpret_cast<memory_address_t>(pointer);
+		for (auto* listener : listeners_)
+			listener->before_write(address, static_cast<uint64_t>(value));
 		interface_->write(address, static_cast<uint64_t>(value));
+		for (auto* listener : listeners_)
+			listener->on_write(address, static_cast<uint64_t>(value));
 	}
 	
 	template<typename Value, typename Ptr>
@@ -154,11 +267,17 @@ public:
 	{
 		assert(interface_);
 		auto address = reinterpret_cast<memory_address_t>(pointer);
-		return static_cast<Value>(interface_->read(address));
+		for (auto* listener : listeners_)
+			listener->before_read(address);
+		auto value = interface_->read(address);
+		for (auto* listener : listeners_)
+			listener->on_read(address, value);
+		return static_cast<Value>(value);
 	}
 	
 private:
 	static inline memory_interface* interface_;
+	static inline std::vector<memory_access_listener*> listeners_;
 };
 
 inline uint64_t memory_interface_not_mocked::read(memory_address_t address)
@@ -173,15 +292,63 @@ inline void memory_interface_not_mocked::write(memory_address_t address, uint64_
 
 inline memory_interface_not_mocked::memory_interface_not_mocked(memory_interface_mock& mock) noexcept
 	: mock_(mock)
+	, previous_interface_(memory_controller::get_interface())
 {
 	memory_controller::set_interface(this);
 }
 	
 inline memory_interface_not_mocked::~memory_interface_not_mocked()
 {
-	memory_controller::set_interface(&mock_);
+	memory_controller::set_interface(previous_interface_);
 }
 
+class flat_memory_interface : public memory_interface
+{
+public:
+	flat_memory_interface(const flat_memory_interface&) = delete;
+	flat_memory_interface& operator=(const flat_memory_interface&) = delete;
+	
+	explicit flat_memory_interface(memory_interface_mock& mock) noexcept
+		: mock_(mock)
+	{
+	}
+	
+	virtual void write(memory_address_t address, uint64_t value) override
+	{
+		if (is_watched(address))
+			mock_.write(address, value);
+		else
+			mock_.set(address, value);
+	}
+	
+	virtual uint64_t read(memory_address_t address) override
+	{
+		if (is_watched(address))
+			return mock_.read(address);
+		return mock_.get(address);
+	}
+	
+	void watch(memory_address_t address)
+	{
+		if (!is_watched(address))
+			watched_.push_back(address);
+	}
+	
+	void unwatch_all() noexcept
+	{
+		watched_.clear();
+	}
+	
+	[[nodiscard]] bool is_watched(memory_address_t address) const noexcept
+	{
+		return std::find(watched_.cbegin(), watched_.cend(), address) != watched_.cend();
+	}
+	
+private:
+	memory_interface_mock& mock_;
+	std::vector<memory_address_t> watched_;
+};
+
 template<typename Pointer>
 static memory_address_t addr(const Pointer* pointer) noexcept
 {
@@ -227,6 +394,46 @@ public:
 	}
 };
 
+class flat_test_fixture_base : virtual public ::testing::Test
+{
+public:
+	virtual void SetUp() override
+	{
+		memory_controller::set_interface(&flat_memory_);
+		memory_mock_.initialize_default_behavior(false);
+	}
+	
+	virtual void TearDown() override
+	{
+		memory_controller::set_interface(nullptr);
+	}
+	
+	[[nodiscard]] memory_interface_mock& memory() noexcept
+	{
+		return memory_mock_;
+	}
+	
+	[[nodiscard]] flat_memory_interface& flat_memory() noexcept
+	{
+		return flat_memory_;
+	}
+	
+	void watch(memory_address_t address)
+	{
+		flat_memory_.watch(address);
+	}
+	
+	template<typename Pointer>
+	[[nodiscard]] static memory_address_t addr(const Pointer* pointer) noexcept
+	{
+		return mcutl::tests::memory::addr(pointer);
+	}
+	
+private:
+	::testing::StrictMock<memory_interface_mock> memory_mock_;
+	flat_memory_interface flat_memory_ { memory_mock_ };
+};
+
 } //namespace mcutl::tests::memory
 
 namespace mcutl::device::memory
@@ -246,6 +453,12 @@ template<typename Type, typename Address>
 	return reinterpret_cast<volatile Type*>(address);
 }
 
+template<typename Type, auto Address>
+[[nodiscard]] inline volatile Type* pinned_volatile_memory() noexcept
+{
+	return volatile_memory<Type, Address>();
+}
+
 template<typename Pointer>
 [[nodiscard]] inline uintptr_t to_address(volatile Pointer* pointer) noexcept
 {
@@ -644,4 +857,24 @@ template<auto BitMask, size_t RegArrIndex, typename RegType, typename RegStruct>
 		return reg_type{};
 }
 
+//Test memory layer does not emulate bit-banding, so any partial bit mask
+//is set using a read-modify-write sequence
+template<auto BitMask, auto Reg, uintptr_t RegStructBase>
+constexpr std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>, bool>
+	set_register_bits_needs_read() noexcept
+{
+	using reg_type = std::remove_cv_t<types::type_of_member_pointer_t<Reg>>;
+	constexpr auto unsigned_bitmask = static_cast<std::make_unsigned_t<reg_type>>(BitMask);
+	return unsigned_bitmask && unsigned_bitmask != max_bitmask<decltype(unsigned_bitmask)>;
+}
+
+template<auto BitMask, auto Reg, size_t RegArrIndex, uintptr_t RegStructBase>
+constexpr std::enable_if_t<std::is_member_object_pointer_v<decltype(Reg)>, bool>
+	set_register_array_bits_needs_read() noexcept
+{
+	using reg_type = std::remove_cv_t<std::remove_all_extents_t<types::type_of_member_pointer_t<Reg>>>;
+	constexpr auto unsigned_bitmask = static_cast<std::make_unsigned_t<reg_type>>(BitMask);
+	return unsigned_bitmask && unsigned_bitmask != max_bitmask<decltype(unsigned_bitmask)>;
+}
+
 } //namespace mcutl::device::memory
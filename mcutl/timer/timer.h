@@ -1,7 +1,13 @@
 #pragma once
 
+#include <array>
+#include <stddef.h>
+#include <stdint.h>
+#include <utility>
+
 #include "mcutl/timer/timer_defs.h"
 #include "mcutl/device/timer/device_timer.h"
+#include "mcutl/memory/init_table.h"
 #include "mcutl/utils/definitions.h"
 #include "mcutl/utils/options_parser.h"
 
@@ -49,6 +55,21 @@ void configure() MCUTL_NOEXCEPT
 		return detail::parse_and_validate_timer_options<Timer, Options...>(); });
 }
 
+template<typename Timer, typename... Options>
+[[nodiscard]] constexpr auto get_init_table_builder() noexcept
+{
+	return device::timer::get_init_table_builder<Timer>([] () constexpr {
+		return detail::parse_and_validate_timer_options<Timer, Options...>();
+	});
+}
+
+template<typename Timer, typename... Options>
+[[nodiscard]] constexpr auto get_init_table() noexcept
+{
+	return mcutl::memory::make_init_table(
+		[] () constexpr { return get_init_table_builder<Timer, Options...>(); });
+}
+
 template<typename Timer, typename... Options>
 void reconfigure() MCUTL_NOEXCEPT
 {
@@ -57,6 +78,104 @@ void reconfigure() MCUTL_NOEXCEPT
 	});
 }
 
+template<typename Timer, typename ProfileSet, template<typename> typename TimingOption>
+class profile_timing
+{
+public:
+	using profile_set_type = ProfileSet;
+	
+	[[nodiscard]] static constexpr uint64_t get_input_frequency(size_t profile) noexcept
+	{
+		return timings_[profile].input_frequency;
+	}
+	
+	[[nodiscard]] static constexpr uint64_t get_prescaler(size_t profile) noexcept
+	{
+		return timings_[profile].prescaler;
+	}
+	
+	[[nodiscard]] static constexpr uint64_t get_reload_value(size_t profile) noexcept
+	{
+		return timings_[profile].reload_value;
+	}
+	
+	//Generates an update event after the values are set, because the prescaler is buffered
+	static void retime(size_t profile) MCUTL_NOEXCEPT
+	{
+		if constexpr (has_prescaler_)
+			device::timer::set_prescaler<Timer>(static_cast<uint32_t>(timings_[profile].prescaler));
+		if constexpr (has_reload_value_)
+			device::timer::set_reload_value<Timer>(static_cast<uint32_t>(timings_[profile].reload_value));
+		device::timer::generate_update_event<Timer>();
+	}
+	
+private:
+	struct timing
+	{
+		uint64_t input_frequency = 0;
+		uint64_t prescaler = detail::unset_value;
+		uint64_t reload_value = detail::unset_value;
+	};
+	
+	template<size_t Profile>
+	static constexpr auto get_profile_options() noexcept
+	{
+		return detail::parse_and_validate_timer_options<Timer,
+			TimingOption<typename ProfileSet::template profile_t<Profile>>>();
+	}
+	
+	template<size_t Profile>
+	static constexpr timing get_profile_timing() noexcept
+	{
+		using timer_frequency = decltype(device::timer::get_timer_frequency<Timer,
+			typename ProfileSet::template profile_t<Profile>>());
+		constexpr auto options = get_profile_options<Profile>();
+		
+		timing result;
+		result.input_frequency = timer_frequency::num / timer_frequency::den;
+		result.prescaler = options.prescaler;
+		result.reload_value = options.reload_value;
+		return result;
+	}
+	
+	template<size_t... Profiles>
+	static constexpr auto get_timings(std::index_sequence<Profiles...>) noexcept
+	{
+		return std::array<timing, ProfileSet::profile_count> {
+			get_profile_timing<Profiles>()... };
+	}
+	
+	template<size_t... Profiles>
+	static constexpr size_t get_prescaler_profile_count(std::index_sequence<Profiles...>) noexcept
+	{
+		return (size_t {} + ... + (get_profile_options<Profiles>().prescaler_set_count ? 1u : 0u));
+	}
+	
+	template<size_t... Profiles>
+	static constexpr size_t get_reload_value_profile_count(std::index_sequence<Profiles...>) noexcept
+	{
+		return (size_t {} + ... + (get_profile_options<Profiles>().reload_value_set_count ? 1u : 0u));
+	}
+	
+private:
+	using profile_indices = std::make_index_sequence<ProfileSet::profile_count>;
+	
+	static constexpr size_t prescaler_profile_count_ = get_prescaler_profile_count(profile_indices());
+	static constexpr size_t reload_value_profile_count_ = get_reload_value_profile_count(profile_indices());
+	static_assert(prescaler_profile_count_ == 0 || prescaler_profile_count_ == ProfileSet::profile_count,
+		"TimingOption must set the timer prescaler either for all profiles or for none of them");
+	static_assert(reload_value_profile_count_ == 0
+		|| reload_value_profile_count_ == ProfileSet::profile_count,
+		"TimingOption must set the timer reload value either for all profiles or for none of them");
+	
+	static constexpr bool has_prescaler_ = prescaler_profile_count_ != 0;
+	static constexpr bool has_reload_value_ = reload_value_profile_count_ != 0;
+	static_assert(has_prescaler_ || has_reload_value_,
+		"TimingOption must set the timer prescaler or reload value");
+	
+	static constexpr auto timings_ = get_timings(profile_indices());
+};
+
 template<typename Timer>
 [[nodiscard]] auto get_timer_count() MCUTL_NOEXCEPT
 {
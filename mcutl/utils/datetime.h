@@ -149,7 +149,7 @@ struct date_time_with_timestamp : date_time
 	return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
 }
 
-[[nodiscard]] day_type get_number_of_days(year_type year, month_type month) noexcept
+[[nodiscard]] inline day_type get_number_of_days(year_type year, month_type month) noexcept
 {
 	static constexpr const uint8_t days_in_month[] { 0, 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
 	return month != 2 || !is_leap(year) ? days_in_month[month] : 29u;
@@ -8,3 +8,4 @@
 
 #define MCUTL_STATIC_FORCEINLINE __attribute__((always_inline)) static __inline
 #define MCUTL_STATIC_NAKED_NOINLINE __attribute__((noinline, naked)) static
+#define MCUTL_NOINLINE __attribute__((noinline))
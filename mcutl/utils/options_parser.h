@@ -67,22 +67,43 @@ constexpr auto parse_options() noexcept
 	return result;
 }
 
+namespace detail
+{
+
+//Options are parsed once per options pack, and the result is shared by all validators
+template<typename Result, template<typename, typename> class OptionsParser,
+	typename Peripheral, typename... Options>
+struct parsed_peripheral_options
+{
+	static constexpr Result value = parse_options<Result, OptionsParser, Peripheral, Options...>();
+};
+
+template<typename Result, template<typename> class OptionsParser, typename... Options>
+struct parsed_options
+{
+	static constexpr Result value = parse_options<Result, OptionsParser, Options...>();
+};
+
+} //namespace detail
+
 template<typename Result, template<typename, typename> class OptionsParser,
 	typename Peripheral, typename... Options>
 constexpr auto parse_and_validate_options() noexcept
 {
+	using parsed = detail::parsed_peripheral_options<Result, OptionsParser, Peripheral, Options...>;
 	(..., OptionsParser<Peripheral, Options>::template validate([]() constexpr {
-		return parse_options<Result, OptionsParser, Peripheral, Options...>(); }));
-	return parse_options<Result, OptionsParser, Peripheral, Options...>();
+		return parsed::value; }));
+	return parsed::value;
 }
 
 template<typename Result, template<typename> class OptionsParser,
 	typename... Options>
 constexpr auto parse_and_validate_options() noexcept
 {
+	using parsed = detail::parsed_options<Result, OptionsParser, Options...>;
 	(..., OptionsParser<Options>::template validate([]() constexpr {
-		return parse_options<Result, OptionsParser, Options...>(); }));
-	return parse_options<Result, OptionsParser, Options...>();
+		return parsed::value; }));
+	return parsed::value;
 }
 
 } //namespace mcutl::opts
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 
 namespace mcutl::types
 {
@@ -86,50 +87,58 @@ struct identity
 namespace detail
 {
 
-template<template <typename...> typename Container, typename... Containers>
-struct merge_containers {};
+//All type list algorithms below are implemented with pack expansions and fold expressions
+//instead of recursive instantiations, so their instantiation depth does not depend on the list length.
 
-template<template <typename...> typename Container,
-	template <typename...> typename Container1, typename... Types1>
-struct merge_containers<Container, Container1<Types1...>>
+template<typename... T>
+struct concat_list
 {
-	using type = Container<Types1...>;
+	using type = list<T...>;
 };
 
-template<template <typename...> typename Container,
-	template <typename...> typename Container1, typename... Types1,
-	template <typename...> typename Container2, typename... Types2,
-	typename... OtherContainers>
-struct merge_containers<Container, Container1<Types1...>,
-	Container2<Types2...>, OtherContainers...>
+template<typename... Types1, typename... Types2>
+concat_list<Types1..., Types2...> operator+(concat_list<Types1...>, concat_list<Types2...>) noexcept;
+
+template<typename... Lists>
+using concat_t = typename decltype((std::declval<concat_list<>>() + ... + std::declval<Lists>()))::type;
+
+template<typename Container>
+struct to_concat_list {};
+
+template<template <typename...> typename Container, typename... Types>
+struct to_concat_list<Container<Types...>>
 {
-	using type = typename merge_containers<Container,
-		Container<Types1..., Types2...>, OtherContainers...>::type;
+	using type = concat_list<Types...>;
 };
 
-template<template <typename...> typename Container, typename...>
-struct pop_back {};
+template<bool Keep, typename T>
+using keep_if_t = std::conditional_t<Keep, concat_list<T>, concat_list<>>;
 
-template<template <typename...> typename Container>
-struct pop_back<Container, list<>>
+template<bool... Values>
+constexpr std::size_t find_first_true() noexcept
 {
-	using type = Container<>;
-};
+	constexpr bool values[] { Values..., true };
+	std::size_t index = 0;
+	while (!values[index])
+		++index;
+	return index;
+}
 
-template<template <typename...> typename Container,
-	typename... Types, typename Remaining>
-struct pop_back<Container, list<Types...>, Remaining>
+template<template <typename...> typename Container, typename... Containers>
+struct merge_containers
 {
-	using type = Container<Types...>;
+	using type = typename concat_t<typename to_concat_list<Containers>::type...>
+		::template apply<Container>;
 };
 
-template<template <typename...> typename Container,
-	typename... Types,
-	typename Remaining, typename Remaining2, typename... OtherRemaining>
-struct pop_back<Container, list<Types...>, Remaining, Remaining2, OtherRemaining...>
+template<typename Container, typename Indices>
+struct pop_back_indexed {};
+
+template<template <typename...> typename Container, typename... Types, std::size_t... Indices>
+struct pop_back_indexed<Container<Types...>, std::index_sequence<Indices...>>
 {
-	using type = typename pop_back<Container,
-		list<Types..., Remaining>, Remaining2, OtherRemaining...>::type;
+	using type = typename concat_t<keep_if_t<(Indices + 1 < sizeof...(Types)), Types>...>
+		::template apply<Container>;
 };
 
 template<typename Container>
@@ -137,8 +146,8 @@ struct pop_back_helper {};
 
 template<template <typename...> typename Container, typename... Types>
 struct pop_back_helper<Container<Types...>>
+	: pop_back_indexed<Container<Types...>, std::index_sequence_for<Types...>>
 {
-	using type = typename pop_back<Container, list<>, Types...>::type;
 };
 
 template<typename Container>
@@ -206,70 +215,77 @@ using push_back_t = typename push_back<Container, Type>::type;
 namespace detail
 {
 
-template<template <typename, typename> typename IsSame, typename...>
-struct duplicate_helper : std::bool_constant<false> {};
-
-template<template <typename, typename> typename IsSame, typename T, typename... Other>
-struct duplicate_helper<IsSame, T, Other...> : std::bool_constant<false> {};
+template<template <typename, typename> typename IsSame, typename List, typename Indices>
+struct duplicate_helper {};
 
-template<template <typename, typename> typename IsSame,
-	typename T, typename Other, typename... Others>
-struct duplicate_helper<IsSame, T, Other, Others...>
+template<template <typename, typename> typename IsSame, typename... T, std::size_t... Indices>
+struct duplicate_helper<IsSame, list<T...>, std::index_sequence<Indices...>>
 {
-	static constexpr bool value = IsSame<T, Other>::value
-		|| duplicate_helper<IsSame, T, Others...>::value
-		|| duplicate_helper<IsSame, Other, Others...>::value;
+	//Each type is compared to the types following it only, as IsSame may be not symmetric
+	template<typename U, std::size_t UIndex>
+	static constexpr bool has_same_after = (false || ...
+		|| std::conditional_t<(Indices > UIndex), IsSame<U, T>, std::false_type>::value);
+	
+	static constexpr bool value = (false || ... || has_same_after<T, Indices>);
 };
 
 } //namespace detail
 
 template<typename... T>
-[[maybe_unused]] constexpr bool has_duplicates_v = detail::duplicate_helper<std::is_same, T...>::value;
+[[maybe_unused]] constexpr bool has_duplicates_v = detail::duplicate_helper<std::is_same,
+	list<T...>, std::index_sequence_for<T...>>::value;
 
 template<template <typename, typename> typename IsSame, typename... T>
-[[maybe_unused]] constexpr bool has_duplicates_filtered_v = detail::duplicate_helper<IsSame, T...>::value;
+[[maybe_unused]] constexpr bool has_duplicates_filtered_v = detail::duplicate_helper<IsSame,
+	list<T...>, std::index_sequence_for<T...>>::value;
 
 namespace detail
 {
 
-template<template <typename...> typename Container, typename...>
-struct remove_helper
-{
-};
+template<typename Remove, typename Container>
+struct remove_container_helper {};
 
-template<template <typename...> typename Container, typename T, typename... Filtered>
-struct remove_helper<Container, T, Container<Filtered...>, Container<>>
+template<typename Remove, template <typename...> typename Container, typename... Types>
+struct remove_container_helper<Remove, Container<Types...>>
 {
-	using type = Container<Filtered...>;
+	using type = typename concat_t<keep_if_t<!std::is_same_v<Remove, Types>, Types>...>
+		::template apply<Container>;
 };
 
-template<template <typename...> typename Container,
-	typename T, typename... Filtered, typename ToFilter, typename... OtherToFilter>
-struct remove_helper<Container, T, Container<Filtered...>, Container<ToFilter, OtherToFilter...>>
+template<typename Container, typename Indices>
+struct remove_duplicates_indexed {};
+
+template<template <typename...> typename Container, typename... Types, std::size_t... Indices>
+struct remove_duplicates_indexed<Container<Types...>, std::index_sequence<Indices...>>
 {
-	using type = typename std::conditional<std::is_same_v<T, ToFilter>,
-		remove_helper<Container, T, Container<Filtered...>, Container<OtherToFilter...>>,
-		remove_helper<Container, T, Container<Filtered..., ToFilter>, Container<OtherToFilter...>>
-	>::type::type;
+	template<typename U, std::size_t UIndex>
+	static constexpr bool is_first = !(false || ... || ((Indices < UIndex) && std::is_same_v<U, Types>));
+	
+	using type = typename concat_t<keep_if_t<is_first<Types, Indices>, Types>...>
+		::template apply<Container>;
 };
 
-template<typename Remove, typename Container>
-struct remove_container_helper {};
+template<typename Container>
+struct remove_duplicates_helper {};
 
-template<typename Remove, template <typename...> typename Container, typename... Types>
-struct remove_container_helper<Remove, Container<Types...>>
+template<template <typename...> typename Container, typename... Types>
+struct remove_duplicates_helper<Container<Types...>>
+	: remove_duplicates_indexed<Container<Types...>, std::index_sequence_for<Types...>>
 {
-	using type = typename remove_helper<Container, Remove, Container<>, Container<Types...>>::type;
 };
 
 } //namespace detail
 
 template<typename Remove, typename... T>
-using remove_t = typename detail::remove_helper<list, Remove, list<>, list<T...>>::type;
+using remove_t = typename detail::remove_container_helper<Remove, list<T...>>::type;
 
 template<typename Remove, typename Container>
 using remove_from_container_t = typename detail::remove_container_helper<Remove, Container>::type;
 
+//Keeps the first occurrence of each type in the Container
+template<typename Container>
+using remove_duplicates_t = typename detail::remove_duplicates_helper<Container>::type;
+
 namespace detail
 {
 
@@ -296,22 +312,11 @@ struct type_index
 	static_assert(always_false<T>::value, "Invalid type list type");
 };
 
-template<typename T, template <typename...> typename List>
-struct type_index<T, List<>>
-{
-	static_assert(always_false<T>::value, "No type T in given type list");
-};
-
 template<typename T, template <typename...> typename List, typename... Types>
-struct type_index<T, List<T, Types...>>
-{
-	static constexpr std::size_t value = 0;
-};
-
-template<typename T, template <typename...> typename List, typename U, typename... Types>
-struct type_index<T, List<U, Types...>>
+struct type_index<T, List<Types...>>
 {
-	static constexpr std::size_t value = 1 + type_index<T, List<Types...>>::value;
+	static constexpr std::size_t value = find_first_true<std::is_same_v<T, Types>...>();
+	static_assert(value != sizeof...(Types), "No type T in given type list");
 };
 
 } //namespace detail
@@ -322,23 +327,27 @@ template<typename T, typename TypeList>
 namespace detail
 {
 
-template<std::size_t Index, typename List>
-struct type_by_index
+template<std::size_t Index, typename List, typename Indices>
+struct type_by_index_helper {};
+
+template<std::size_t Index, template <typename...> typename List,
+	typename... Types, std::size_t... Indices>
+struct type_by_index_helper<Index, List<Types...>, std::index_sequence<Indices...>>
 {
-	static_assert(always_false<List>::value, "Invalid type list type");
+	static_assert(Index < sizeof...(Types), "Too large index value");
+	using type = typename concat_t<keep_if_t<Indices == Index, Types>...>::template apply<first_type_t>;
 };
 
-template<std::size_t Index, template <typename...> typename List>
-struct type_by_index<Index, List<>>
+template<std::size_t Index, typename List>
+struct type_by_index
 {
-	static_assert(value_always_false<Index>::value, "Too large index value");
+	static_assert(always_false<List>::value, "Invalid type list type");
 };
 
-template<std::size_t Index, template <typename...> typename List, typename Type, typename... Types>
-struct type_by_index<Index, List<Type, Types...>>
+template<std::size_t Index, template <typename...> typename List, typename... Types>
+struct type_by_index<Index, List<Types...>>
+	: type_by_index_helper<Index, List<Types...>, std::index_sequence_for<Types...>>
 {
-	using type = typename std::conditional_t<Index == 0,
-		identity<Type>, type_by_index<Index - 1, List<Types...>>>::type;
 };
 
 } //namespace detail
@@ -355,14 +364,8 @@ struct has_type
 	static_assert(always_false<T>::value, "Invalid type list type");
 };
 
-template<typename T, template <typename...> typename List>
-struct has_type<T, List<>> : std::bool_constant<false> {};
-
 template<typename T, template <typename...> typename List, typename... Types>
-struct has_type<T, List<T, Types...>> : std::bool_constant<true> {};
-
-template<typename T, template <typename...> typename List, typename U, typename... Types>
-struct has_type<T, List<U, Types...>> : has_type<T, List<Types...>> {};
+struct has_type<T, List<Types...>> : std::bool_constant<(false || ... || std::is_same_v<T, Types>)> {};
 
 } //namespace detail
 
@@ -372,18 +375,16 @@ template<typename T, typename TypeList>
 namespace detail
 {
 
-template<typename Base, typename Tuple, std::size_t I = 0>
+template<typename Base, typename Tuple>
 struct tuple_ref_index : std::integral_constant<int, -1>
 {
 };
 
-template<typename Base, typename Head, typename... Tail, std::size_t I>
-struct tuple_ref_index<Base, std::tuple<Head, Tail...>, I>  
-    : std::conditional<std::is_base_of_v<Base, std::decay_t<Head>>
-                     , std::integral_constant<std::size_t, I>
-                     , tuple_ref_index<Base, std::tuple<Tail...>, I + 1>
-                     >::type
+template<typename Base, typename... Types>
+struct tuple_ref_index<Base, std::tuple<Types...>>
 {
+	static constexpr std::size_t index = find_first_true<std::is_base_of_v<Base, std::decay_t<Types>>...>();
+	static constexpr auto value = index == sizeof...(Types) ? -1 : static_cast<int>(index);
 };
 
 } //namespace detail
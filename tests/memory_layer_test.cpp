@@ -1,10 +1,15 @@
 #define STM32F103xE
 #define STM32F1
 
+#include <sstream>
 #include <stddef.h>
 #include <type_traits>
+#include <utility>
 
+#include "mcutl/memory/init_table.h"
 #include "mcutl/memory/volatile_memory.h"
+#include "mcutl/tests/access_counter.h"
+#include "mcutl/tests/access_trace.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -12,6 +17,7 @@
 struct test_register
 {
 	uint32_t reg1 = 0;
+	uint32_t reg2 = 0;
 };
 
 struct test_register_array
@@ -335,3 +341,301 @@ TEST_F(memory_layer_test_fixture, MemoryLayerGetRegisterArrayFlag)
 	expect_get_register_array_bits(bits, array_index);
 	EXPECT_FALSE((mcutl::memory::get_register_array_flag<false_mask, array_index>(&test_register_array::reg_array, test_reg_array_ptr)));
 }
+
+TEST_F(memory_layer_test_fixture, MemoryLayerSetRegistersMergesSameRegister)
+{
+	constexpr uint32_t reg2_address = test_address + offsetof(test_register, reg2);
+	constexpr uint32_t initial_value = 0b11110000111100001111000011110000u;
+	memory().set(reg_address, initial_value);
+	memory().set(reg2_address, initial_value);
+	
+	::testing::InSequence s;
+	EXPECT_CALL(memory(), read(reg_address));
+	EXPECT_CALL(memory(), write(reg_address,
+		(initial_value & ~0b11111111u) | 0b10100101u));
+	EXPECT_CALL(memory(), read(reg2_address));
+	EXPECT_CALL(memory(), write(reg2_address,
+		(initial_value & ~0b1100u) | 0b0100u));
+	
+	mcutl::memory::set_registers<
+		mcutl::memory::register_bits<0b00001111u, 0b0101u, &test_register::reg1, test_address>,
+		mcutl::memory::register_bits<0b1100u, 0b0100u, &test_register::reg2, test_address>,
+		mcutl::memory::register_bits<0b11110000u, 0b10100000u, &test_register::reg1, test_address>
+	>();
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerSetRegistersLastWriteWins)
+{
+	constexpr uint32_t initial_value = 0b11110000u;
+	memory().set(reg_address, initial_value);
+	
+	::testing::InSequence s;
+	EXPECT_CALL(memory(), read(reg_address));
+	EXPECT_CALL(memory(), write(reg_address, 0b11100001u));
+	
+	mcutl::memory::set_registers<
+		mcutl::memory::register_bits<0b00110011u, 0b00110011u, &test_register::reg1, test_address>,
+		mcutl::memory::register_bits<0b00010010u, 0b00000000u, &test_register::reg1, test_address>
+	>();
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerSetRegistersFullValueSkipsRead)
+{
+	constexpr uint32_t value = 0b1010101010101010u;
+	
+	EXPECT_CALL(memory(), write(reg_address, (value & ~0b1111u) | 0b0110u));
+	
+	mcutl::memory::set_registers<
+		mcutl::memory::register_value<value, &test_register::reg1, test_address>,
+		mcutl::memory::register_bits<0b1111u, 0b0110u, &test_register::reg1, test_address>
+	>();
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerSetRegistersArray)
+{
+	constexpr uint32_t initial_value = 0b11110000u;
+	constexpr uint32_t field0_address = reg_array_address;
+	constexpr uint32_t field1_address = reg_array_address + sizeof(uint32_t);
+	memory().set(field0_address, initial_value);
+	
+	::testing::InSequence s;
+	EXPECT_CALL(memory(), read(field0_address));
+	EXPECT_CALL(memory(), write(field0_address, 0b00001111u));
+	EXPECT_CALL(memory(), write(field1_address, 0x12345678u));
+	
+	mcutl::memory::set_registers<
+		mcutl::memory::register_array_bits<0b11000011u, 0b00000011u,
+			&test_register_array::reg_array, 0, test_array_address>,
+		mcutl::memory::register_array_value<0x12345678u,
+			&test_register_array::reg_array, 1, test_array_address>,
+		mcutl::memory::register_array_bits<0b00111100u, 0b00001100u,
+			&test_register_array::reg_array, 0, test_array_address>
+	>();
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerRegisterBlock)
+{
+	constexpr uint32_t bits = 0b1010101010101010u;
+	constexpr uint32_t mask = 0b1000011111000011u;
+	mcutl::memory::register_block<test_register, test_address> block;
+	EXPECT_EQ(block.get(), test_reg_ptr);
+	
+	expect_set_register_bits(mask, bits & mask);
+	mcutl::memory::set_register_bits<mask, bits, &test_register::reg1>(block);
+	
+	expect_set_register_bits(mask, bits & mask);
+	mcutl::memory::set_register_bits<mask, &test_register::reg1>(block, bits);
+	
+	expect_set_register_value(bits);
+	mcutl::memory::set_register_value<bits, &test_register::reg1>(block);
+	
+	expect_set_register_value(bits);
+	mcutl::memory::set_register_value<&test_register::reg1>(block, bits);
+	
+	expect_get_register_bits(bits);
+	EXPECT_EQ((mcutl::memory::get_register_bits<&test_register::reg1>(block)), bits);
+	
+	expect_get_register_bits(bits);
+	EXPECT_EQ((mcutl::memory::get_register_bits<mask, &test_register::reg1>(block)), bits & mask);
+	
+	expect_get_register_bits(bits);
+	EXPECT_TRUE((mcutl::memory::get_register_flag<mask, &test_register::reg1>(block)));
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerRegisterArrayBlock)
+{
+	constexpr uint32_t bits = 0b1010101010101010u;
+	constexpr uint32_t mask = 0b1000011111000011u;
+	constexpr uint32_t array_index = 1;
+	mcutl::memory::register_block<test_register_array, test_array_address> block;
+	EXPECT_EQ(block.get(), test_reg_array_ptr);
+	
+	expect_set_register_array_bits(mask, bits & mask, array_index);
+	mcutl::memory::set_register_array_bits<mask, bits,
+		&test_register_array::reg_array, array_index>(block);
+	
+	expect_set_register_array_bits(mask, bits & mask, array_index);
+	mcutl::memory::set_register_array_bits<mask,
+		&test_register_array::reg_array, array_index>(block, bits);
+	
+	expect_set_register_array_value(bits, array_index);
+	mcutl::memory::set_register_array_value<bits,
+		&test_register_array::reg_array, array_index>(block);
+	
+	expect_set_register_array_value(bits, array_index);
+	mcutl::memory::set_register_array_value<&test_register_array::reg_array,
+		array_index>(block, bits);
+	
+	expect_get_register_array_bits(bits, array_index);
+	EXPECT_EQ((mcutl::memory::get_register_array_bits<&test_register_array::reg_array,
+		array_index>(block)), bits);
+	
+	expect_get_register_array_bits(bits, array_index);
+	EXPECT_EQ((mcutl::memory::get_register_array_bits<mask, &test_register_array::reg_array,
+		array_index>(block)), bits & mask);
+	
+	expect_get_register_array_bits(bits, array_index);
+	EXPECT_TRUE((mcutl::memory::get_register_array_flag<mask, &test_register_array::reg_array,
+		array_index>(block)));
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerInitTableBuilder)
+{
+	constexpr auto table = mcutl::memory::make_init_table([] () constexpr {
+		mcutl::memory::init_table_builder<8> builder;
+		builder.set_bits(reg_address, 0b1100u, 0b1111u)
+			.set_bits(reg_address, 0u, 0b1111u)
+			.set_value(reg_address, 0x12345678u)
+			.read(reg_address)
+			.wait(reg_address, 0b11u, 0b111u);
+		return builder;
+	});
+	
+	static_assert(table.size() == 4u);
+	static_assert(table[0].mask == 0b1100u && table[0].value == 0b1100u);
+	static_assert(table[1].mask == 0xffffffffu && table[1].value == 0x12345678u);
+	static_assert(!table[2].mask && !table[2].wait_mask);
+	static_assert(table[3].wait_mask == 0b11u && table[3].wait_value == 0b11u);
+	
+	constexpr auto joined = mcutl::memory::join_init_tables(table, table);
+	static_assert(joined.size() == 8u);
+	static_assert(joined[5].value == 0x12345678u);
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerApplyInitTable)
+{
+	constexpr uint32_t reg2_address = test_address + offsetof(test_register, reg2);
+	constexpr auto table = mcutl::memory::make_init_table([] () constexpr {
+		mcutl::memory::init_table_builder<4> builder;
+		builder.set_bits(reg_address, 0xff00u, 0xab00u)
+			.set_value(reg2_address, 0x12345678u)
+			.read(reg_address)
+			.wait(reg2_address, 0b11u, 0b10u);
+		return builder;
+	});
+	
+	memory().set(reg_address, 0x123456u);
+	
+	::testing::InSequence s;
+	EXPECT_CALL(memory(), read(reg_address));
+	EXPECT_CALL(memory(), write(reg_address, 0x12ab56u));
+	EXPECT_CALL(memory(), write(reg2_address, 0x12345678u));
+	EXPECT_CALL(memory(), read(reg_address));
+	EXPECT_CALL(memory(), read(reg2_address))
+		.WillOnce(::testing::Return(0b01u))
+		.WillOnce(::testing::Return(0b11u))
+		.WillOnce(::testing::Return(0b110u));
+	
+	mcutl::memory::apply_init_table(table);
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerAccessCounter)
+{
+	constexpr uint32_t reg2_address = test_address + offsetof(test_register, reg2);
+	memory().allow_all_accesses();
+	
+	mcutl::tests::memory::access_counter counter;
+	mcutl::memory::set_register_value<0x123u, &test_register::reg2, test_address>();
+	
+	auto count = counter.measure("set_register_bits", [] {
+		mcutl::memory::set_register_bits<0xf0u, 0x30u, &test_register::reg1, test_address>();
+	});
+	EXPECT_EQ(count, (mcutl::tests::memory::access_count{ 1u, 1u }));
+	
+	EXPECT_TRUE(counter.within_budget("get_register_bits", 1u, [] {
+		[[maybe_unused]] auto value
+			= mcutl::memory::get_register_bits<&test_register::reg2, test_address>();
+	}));
+	EXPECT_FALSE(counter.within_budget("set_registers", 1u, [] {
+		mcutl::memory::set_register_bits<0xf0u, 0x30u, &test_register::reg1, test_address>();
+	}));
+	
+	EXPECT_EQ(counter.get_total(), (mcutl::tests::memory::access_count{ 3u, 3u }));
+	EXPECT_EQ(counter.get(reg_address), (mcutl::tests::memory::access_count{ 2u, 2u }));
+	EXPECT_EQ(counter.get(reg2_address), (mcutl::tests::memory::access_count{ 1u, 1u }));
+	EXPECT_EQ(counter.get("set_register_bits"), (mcutl::tests::memory::access_count{ 1u, 1u }));
+	
+	std::ostringstream report;
+	counter.report(report);
+	EXPECT_EQ(report.str(),
+		"Total: 3 reads, 3 writes\n"
+		"get_register_bits: 1 reads, 0 writes\n"
+		"set_register_bits: 1 reads, 1 writes\n"
+		"set_registers: 1 reads, 1 writes\n"
+		"0x12345678: 2 reads, 2 writes\n"
+		"0x1234567c: 1 reads, 1 writes\n");
+	
+	counter.reset();
+	EXPECT_EQ(counter.get_total().total(), 0u);
+}
+
+TEST_F(memory_layer_test_fixture, MemoryLayerAccessTrace)
+{
+	memory().allow_all_accesses();
+	memory().set(reg_address, 0xabu);
+	
+	mcutl::tests::memory::access_trace trace;
+	mcutl::memory::set_register_bits<0xf0u, 0x30u, &test_register::reg1, test_address>();
+	
+	std::ostringstream text;
+	trace.save(text);
+	EXPECT_EQ(text.str(), "R 0x12345678 0x000000ab\nW 0x12345678 0x0000003b\n");
+	
+	std::istringstream input("# comment\n\n" + text.str());
+	auto records = mcutl::tests::memory::access_trace::load(input);
+	EXPECT_EQ(records, trace.get_records());
+	
+	EXPECT_TRUE(trace.matches_golden("memory_layer_set_register_bits"));
+	mcutl::memory::set_register_value<0x1u, &test_register::reg1, test_address>();
+	if (!mcutl::tests::memory::update_golden_traces_requested())
+	{
+		EXPECT_FALSE(trace.matches_golden("memory_layer_set_register_bits"));
+	}
+}
+
+class memory_layer_flat_test_fixture : public mcutl::tests::memory::flat_test_fixture_base
+{
+public:
+	static constexpr uint32_t test_address = memory_layer_test_fixture::test_address;
+	static constexpr uint32_t reg1_address = test_address + offsetof(test_register, reg1);
+	static constexpr uint32_t reg2_address = test_address + offsetof(test_register, reg2);
+};
+
+TEST_F(memory_layer_flat_test_fixture, MemoryLayerFlatMemory)
+{
+	memory().set_same_address_access_limit(0);
+	memory().set(reg1_address, 0xff00u);
+	watch(reg2_address);
+	
+	EXPECT_TRUE(flat_memory().is_watched(reg2_address));
+	EXPECT_FALSE(flat_memory().is_watched(reg1_address));
+	
+	EXPECT_CALL(memory(), read(reg2_address)).WillOnce(::testing::Return(0x5u));
+	EXPECT_CALL(memory(), write(reg2_address, 0x7u));
+	
+	for (uint32_t i = 0; i != 1000u; ++i)
+		mcutl::memory::set_register_bits<0xffu, 0x12u, &test_register::reg1, test_address>();
+	mcutl::memory::set_register_bits<0x2u, 0x2u, &test_register::reg2, test_address>();
+	
+	EXPECT_EQ(memory().get(reg1_address), 0xff12u);
+	EXPECT_EQ((mcutl::memory::get_register_bits<&test_register::reg1, test_address>()), 0xff12u);
+}
+
+TEST(memory_layer_paged_memory, MemoryLayerPagedMemory)
+{
+	mcutl::tests::memory::paged_memory memory;
+	constexpr auto page_size = mcutl::tests::memory::paged_memory::page_size;
+	
+	EXPECT_EQ(std::as_const(memory).get(0x40021000u), 0u);
+	memory.set(0x40021000u, 1u);
+	memory.set(0x40021000u + page_size, 2u);
+	memory.get(0x20000000u) = 3u;
+	
+	EXPECT_EQ(std::as_const(memory).get(0x40021000u), 1u);
+	EXPECT_EQ(std::as_const(memory).get(0x40021000u + page_size), 2u);
+	EXPECT_EQ(std::as_const(memory).get(0x20000000u), 3u);
+	EXPECT_EQ(std::as_const(memory).get(0x20000004u), 0u);
+	
+	memory.clear();
+	EXPECT_EQ(std::as_const(memory).get(0x40021000u), 0u);
+}
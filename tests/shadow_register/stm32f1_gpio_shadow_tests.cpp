@@ -0,0 +1,80 @@
+#define STM32F103xE
+#define STM32F1
+
+#include <stdint.h>
+
+#include "mcutl/device/device.h"
+#include "mcutl/memory/shadow_register.h"
+
+template<>
+struct mcutl::memory::shadow_register_traits<&GPIO_TypeDef::CRL, GPIOF_BASE>
+	: mcutl::memory::shadowed_register<0x44444444u>
+{
+};
+
+template<>
+struct mcutl::memory::shadow_register_traits<&GPIO_TypeDef::CRH, GPIOF_BASE>
+	: mcutl::memory::shadowed_register<0x44444444u, mcutl::memory::shadow_mode::checked>
+{
+};
+
+#include "mcutl/gpio/gpio.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+using gpio_shadow_strict_test_fixture = mcutl::tests::memory::strict_test_fixture_base;
+
+TEST_F(gpio_shadow_strict_test_fixture, ShadowedRegisterSkipsReadTest)
+{
+	::testing::InSequence s;
+	
+	memory().set(addr(&GPIOF->CRL), 0x44444444u);
+	EXPECT_CALL(memory(), read(addr(&GPIOF->CRL)));
+	mcutl::memory::load_shadow_register<&GPIO_TypeDef::CRL, GPIOF_BASE>();
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOF->CRL), 0x44444344u));
+	mcutl::gpio::configure_gpio<
+		mcutl::gpio::as_output<mcutl::gpio::gpiof<2>, mcutl::gpio::out::push_pull>
+	>();
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOF->CRL), 0x44444444u));
+	mcutl::gpio::configure_gpio<
+		mcutl::gpio::as_input<mcutl::gpio::gpiof<2>, mcutl::gpio::in::floating>
+	>();
+	
+	EXPECT_EQ((mcutl::memory::get_shadow_register_value<&GPIO_TypeDef::CRL, GPIOF_BASE>()),
+		0x44444444u);
+}
+
+TEST_F(gpio_shadow_strict_test_fixture, CheckedShadowedRegisterTest)
+{
+	::testing::InSequence s;
+	
+	memory().set(addr(&GPIOF->CRH), 0x44444444u);
+	EXPECT_CALL(memory(), read(addr(&GPIOF->CRH)));
+	mcutl::memory::load_shadow_register<&GPIO_TypeDef::CRH, GPIOF_BASE>();
+	
+	auto mismatch_count = mcutl::memory::get_shadow_register_mismatch_count<
+		&GPIO_TypeDef::CRH, GPIOF_BASE>();
+	
+	EXPECT_CALL(memory(), read(addr(&GPIOF->CRH)));
+	EXPECT_CALL(memory(), write(addr(&GPIOF->CRH), 0x44444434u));
+	mcutl::gpio::configure_gpio<
+		mcutl::gpio::as_output<mcutl::gpio::gpiof<9>, mcutl::gpio::out::push_pull>
+	>();
+	EXPECT_EQ((mcutl::memory::get_shadow_register_mismatch_count<
+		&GPIO_TypeDef::CRH, GPIOF_BASE>()), mismatch_count);
+	
+	//Register was changed bypassing the shadow copy
+	memory().set(addr(&GPIOF->CRH), 0x44444488u);
+	EXPECT_CALL(memory(), read(addr(&GPIOF->CRH)));
+	EXPECT_CALL(memory(), write(addr(&GPIOF->CRH), 0x44444448u));
+	mcutl::gpio::configure_gpio<
+		mcutl::gpio::as_input<mcutl::gpio::gpiof<9>, mcutl::gpio::in::floating>
+	>();
+	EXPECT_EQ((mcutl::memory::get_shadow_register_mismatch_count<
+		&GPIO_TypeDef::CRH, GPIOF_BASE>()), mismatch_count + 1);
+	EXPECT_EQ((mcutl::memory::get_shadow_register_value<&GPIO_TypeDef::CRH, GPIOF_BASE>()),
+		0x44444448u);
+}
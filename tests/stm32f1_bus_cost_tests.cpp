@@ -0,0 +1,280 @@
+#define STM32F103xG
+#define STM32F1
+
+#include <stdint.h>
+
+#include "mcutl/clock/clock.h"
+#include "mcutl/dma/dma.h"
+#include "mcutl/gpio/gpio.h"
+#include "mcutl/interrupt/interrupt.h"
+#include "mcutl/memory/bus_cost.h"
+#include "mcutl/memory/init_table.h"
+#include "mcutl/periph/periph.h"
+#include "mcutl/tests/access_counter.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/tests/stm32f1_peripheral_models.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+using namespace mcutl::clock::literals;
+namespace models = mcutl::tests::memory::stm32f1;
+
+namespace
+{
+
+[[nodiscard]] mcutl::tests::memory::access_count to_access_count(
+	const mcutl::memory::bus_cost& cost) noexcept
+{
+	return { cost.reads, cost.writes };
+}
+
+template<typename ClockConfig>
+struct with_base_configuration {};
+
+template<typename... Options>
+struct with_base_configuration<mcutl::clock::config<Options...>>
+{
+	using type = mcutl::clock::config<Options..., mcutl::clock::base_configuration_is_currently_present>;
+};
+
+} //namespace
+
+class bus_cost_test_fixture : public mcutl::tests::mcu::flat_test_fixture_base
+{
+public:
+	mcutl::tests::memory::access_counter& counter() noexcept
+	{
+		return counter_;
+	}
+
+private:
+	mcutl::tests::memory::access_counter counter_;
+};
+
+TEST(bus_cost_test, ArithmeticTest)
+{
+	constexpr mcutl::memory::bus_cost first { 2u, 3u, 1u };
+	constexpr mcutl::memory::bus_cost second { 4u, 1u, 0u };
+	
+	static_assert(first + second == mcutl::memory::bus_cost{ 6u, 4u, 1u });
+	static_assert(mcutl::memory::worst_case(first, second) == mcutl::memory::bus_cost{ 4u, 3u, 1u });
+	static_assert(first.accesses() == 5u);
+	static_assert(first.get_fixed_cycles() == 5u * mcutl::memory::default_bus_access_cycles);
+	static_assert(second.get_fixed_cycles(3u) == 15u);
+	static_assert(!first.is_bounded());
+	static_assert(second.is_bounded());
+	static_assert(mcutl::memory::poll_cost.reads == 1u);
+}
+
+TEST(bus_cost_test, PrimitiveCostTest)
+{
+	static_assert(mcutl::memory::set_register_bits_cost_v<0u, &GPIO_TypeDef::CRL, GPIOA_BASE>
+		== mcutl::memory::bus_cost{});
+	static_assert(mcutl::memory::set_register_bits_cost_v<0xffffffffu, &GPIO_TypeDef::CRL, GPIOA_BASE>
+		== mcutl::memory::write_cost);
+	//The test memory layer does not emulate bit-banding
+	static_assert(mcutl::memory::set_register_bits_cost_v<GPIO_CRL_MODE0_0, &GPIO_TypeDef::CRL, GPIOA_BASE>
+		== mcutl::memory::read_cost + mcutl::memory::write_cost);
+	static_assert(mcutl::memory::set_register_array_bits_cost_v<0xffu, &NVIC_Type::IP, 3u, NVIC_BASE>
+		== mcutl::memory::write_cost);
+	static_assert(mcutl::memory::set_shadowed_register_bits_cost_v<0xfu, &GPIO_TypeDef::CRL, GPIOA_BASE>
+		== mcutl::memory::read_cost + mcutl::memory::write_cost);
+}
+
+TEST_F(bus_cost_test_fixture, PeripheralCostTest)
+{
+	using config = mcutl::periph::config<
+		mcutl::periph::enable<mcutl::periph::gpioa>,
+		mcutl::periph::enable<mcutl::periph::dma1>,
+		mcutl::periph::reset<mcutl::periph::spi2>
+	>;
+	constexpr auto cost = mcutl::periph::configure_peripheral_cost_v<config>;
+	static_assert(cost == mcutl::memory::bus_cost{ 5u, 3u, 0u });
+	
+	auto count = counter().measure("periph", [] { mcutl::periph::configure_peripheral<config>(); });
+	EXPECT_EQ(count, to_access_count(cost));
+}
+
+TEST_F(bus_cost_test_fixture, GpioCostTest)
+{
+	using config = mcutl::gpio::config<
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<5>, mcutl::gpio::out::push_pull, mcutl::gpio::out::one>,
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<10>, mcutl::gpio::in::pull_up>,
+		mcutl::gpio::to_value<mcutl::gpio::gpiob<1>, mcutl::gpio::out::zero>,
+		mcutl::gpio::enable_peripherals
+	>;
+	constexpr auto cost = mcutl::gpio::configure_gpio_cost_v<config>;
+	static_assert(cost.is_bounded());
+	static_assert(cost.get_fixed_cycles() <= 32u, "GPIO configuration latency budget exceeded");
+	
+	auto count = counter().measure("gpio", [] { mcutl::gpio::configure_gpio<config>(); });
+	EXPECT_EQ(count, to_access_count(cost));
+}
+
+TEST_F(bus_cost_test_fixture, InitTableCostTest)
+{
+	constexpr auto table = mcutl::gpio::get_init_table<
+		mcutl::gpio::as_output<mcutl::gpio::gpioc<13>, mcutl::gpio::out::open_drain>,
+		mcutl::gpio::to_value<mcutl::gpio::gpioa<0>, mcutl::gpio::out::one>,
+		mcutl::gpio::enable_peripherals
+	>();
+	constexpr auto cost = mcutl::memory::get_init_table_cost(table);
+	
+	auto count = counter().measure("init table", [&table] { mcutl::memory::apply_init_table(table); });
+	EXPECT_EQ(count, to_access_count(cost));
+}
+
+TEST_F(bus_cost_test_fixture, DmaCostTest)
+{
+	models::dma_model dma(memory(), 0);
+	using channel = mcutl::dma::dma1<3>;
+	using interrupt = mcutl::dma::interrupt::transfer_complete;
+	
+	constexpr auto configure_cost = mcutl::dma::configure_channel_cost_v<channel,
+		mcutl::interrupt::interrupt<interrupt, 2>,
+		mcutl::dma::interrupt::enable_controller_interrupts,
+		mcutl::dma::source<mcutl::dma::data_size::byte,
+			mcutl::dma::address::memory, mcutl::dma::pointer_increment::enabled>,
+		mcutl::dma::destination<mcutl::dma::data_size::byte,
+			mcutl::dma::address::peripheral, mcutl::dma::pointer_increment::disabled>
+	>;
+	//CCR read-modify-write, NVIC priority and enable writes, CCR write
+	static_assert(configure_cost == mcutl::memory::bus_cost{ 1u, 4u, 0u });
+	
+	auto count = counter().measure("configure", [] {
+		mcutl::dma::configure_channel<channel,
+			mcutl::interrupt::interrupt<interrupt, 2>,
+			mcutl::dma::interrupt::enable_controller_interrupts,
+			mcutl::dma::source<mcutl::dma::data_size::byte,
+				mcutl::dma::address::memory, mcutl::dma::pointer_increment::enabled>,
+			mcutl::dma::destination<mcutl::dma::data_size::byte,
+				mcutl::dma::address::peripheral, mcutl::dma::pointer_increment::disabled>
+		>();
+	});
+	EXPECT_EQ(count, to_access_count(configure_cost));
+	
+	constexpr auto reconfigure_cost = mcutl::dma::reconfigure_channel_cost_v<channel,
+		mcutl::dma::interrupt::half_transfer,
+		mcutl::dma::interrupt::enable_controller_interrupts>;
+	count = counter().measure("reconfigure", [] {
+		mcutl::dma::reconfigure_channel<channel,
+			mcutl::dma::interrupt::half_transfer,
+			mcutl::dma::interrupt::enable_controller_interrupts>();
+	});
+	EXPECT_EQ(count, to_access_count(reconfigure_cost));
+	
+	uint8_t data[4] {};
+	count = counter().measure("start", [&data] {
+		mcutl::dma::start_transfer<channel>(data, &SPI1->DR, sizeof(data));
+	});
+	EXPECT_EQ(count, to_access_count(mcutl::dma::start_transfer_cost));
+	
+	count = counter().measure("wait", [] { mcutl::dma::wait_transfer<channel>(); });
+	EXPECT_EQ(count, to_access_count(mcutl::dma::wait_transfer_cost));
+	EXPECT_FALSE(mcutl::dma::wait_transfer_cost.is_bounded());
+}
+
+TEST_F(bus_cost_test_fixture, ClockCostBaseConfigurationTest)
+{
+	models::rcc_model rcc(memory(), 0);
+	memory().set(addr(&RCC->CR), RCC_CR_HSION | RCC_CR_HSIRDY);
+	
+	using config = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+		mcutl::clock::base_configuration_is_currently_present
+	>;
+	constexpr auto cost = mcutl::clock::configure_clocks_cost_v<config>;
+	//HSE ready, PLL ready and system clock switch
+	static_assert(cost.polling_loops == 3u);
+	
+	auto count = counter().measure("clock", [] { mcutl::clock::configure_clocks<config>(); });
+	EXPECT_EQ(count, to_access_count(cost));
+}
+
+TEST_F(bus_cost_test_fixture, ClockCostWorstCaseTest)
+{
+	models::rcc_model rcc(memory(), 0);
+	memory().set(addr(&RCC->CR), RCC_CR_HSEON | RCC_CR_HSERDY | RCC_CR_PLLON | RCC_CR_PLLRDY);
+	memory().set(addr(&RCC->CFGR), RCC_CFGR_SW_PLL | RCC_CFGR_SWS_PLL | RCC_CFGR_HPRE_DIV2);
+	memory().set(addr(&RCC->APB1ENR), RCC_APB1ENR_USBEN);
+	
+	using config = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+		mcutl::clock::provide_usb_frequency
+	>;
+	constexpr auto cost = mcutl::clock::configure_clocks_cost_v<config>;
+	static_assert(cost.polling_loops == 7u);
+	
+	auto count = counter().measure("clock", [] { mcutl::clock::configure_clocks<config>(); });
+	EXPECT_EQ(count, to_access_count(cost));
+}
+
+//One configuration per configure_clocks() path: PLL source, SYSCLK source,
+//HSE mode, clock security system, USB and SPI prescalers
+using clock_cost_configurations = ::testing::Types<
+	mcutl::clock::config<
+		mcutl::clock::internal_high_speed_crystal,
+		mcutl::clock::core<mcutl::clock::required_frequency<8_MHz>>,
+		mcutl::clock::force_skip_pll
+	>,
+	mcutl::clock::config<
+		mcutl::clock::internal_high_speed_crystal,
+		mcutl::clock::core<mcutl::clock::required_frequency<48_MHz>>,
+		mcutl::clock::provide_usb_frequency
+	>,
+	mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::force_skip_pll,
+		mcutl::clock::spi1<mcutl::clock::max_frequency<1_MHz>>
+	>,
+	mcutl::clock::config<
+		mcutl::clock::external_high_speed_bypass<8_MHz>,
+		mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+		mcutl::clock::ahb<mcutl::clock::required_frequency<36_MHz>>,
+		mcutl::clock::spi2<mcutl::clock::max_frequency<1_MHz>>,
+		mcutl::clock::spi3<mcutl::clock::max_frequency<1_MHz>>,
+		mcutl::clock::enable_clock_security_system
+	>
+>;
+
+template<typename ClockConfig>
+class clock_cost_test_fixture_templated : public bus_cost_test_fixture
+{
+public:
+	//Measures configure_clocks() accesses from the worst case initial state
+	//or from the base configuration and compares them with the computed cost
+	template<typename Config>
+	void expect_cost_matches_accesses(bool from_worst_case_state)
+	{
+		if (from_worst_case_state)
+		{
+			memory().set(addr(&RCC->CR), RCC_CR_HSEON | RCC_CR_HSERDY | RCC_CR_HSEBYP
+				| RCC_CR_CSSON | RCC_CR_PLLON | RCC_CR_PLLRDY);
+			memory().set(addr(&RCC->CFGR), RCC_CFGR_SW_PLL | RCC_CFGR_SWS_PLL | RCC_CFGR_HPRE_DIV2);
+			memory().set(addr(&RCC->APB1ENR), RCC_APB1ENR_USBEN);
+		}
+		else
+		{
+			memory().set(addr(&RCC->CR), RCC_CR_HSION | RCC_CR_HSIRDY);
+			memory().set(addr(&RCC->CFGR), 0u);
+			memory().set(addr(&RCC->APB1ENR), 0u);
+		}
+		memory().set(addr(&FLASH->ACR), 0u);
+		
+		models::rcc_model rcc(memory(), 0);
+		auto count = counter().measure("clock", [] { mcutl::clock::configure_clocks<Config>(); });
+		EXPECT_EQ(count, to_access_count(mcutl::clock::configure_clocks_cost_v<Config>));
+	}
+};
+
+TYPED_TEST_SUITE(clock_cost_test_fixture_templated, clock_cost_configurations);
+
+TYPED_TEST(clock_cost_test_fixture_templated, ClockCostMatchesAccessesTest)
+{
+	this->template expect_cost_matches_accesses<TypeParam>(true);
+	this->template expect_cost_matches_accesses<
+		typename with_base_configuration<TypeParam>::type>(false);
+}
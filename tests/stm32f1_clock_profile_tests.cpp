@@ -0,0 +1,358 @@
+#define STM32F103xE
+#define STM32F1
+
+#include <algorithm>
+#include <ratio>
+#include <stdint.h>
+#include <vector>
+
+#include "mcutl/clock/clock.h"
+#include "mcutl/spi/spi.h"
+#include "mcutl/tests/access_counter.h"
+#include "mcutl/tests/access_trace.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/tests/stm32f1_peripheral_models.h"
+#include "mcutl/timer/timer.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+using namespace mcutl::clock::literals;
+namespace models = mcutl::tests::memory::stm32f1;
+
+namespace
+{
+
+using full_speed_profile = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>
+>;
+
+using medium_speed_profile = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<36_MHz>>
+>;
+
+using idle_profile = mcutl::clock::config<
+	mcutl::clock::internal_high_speed_crystal,
+	mcutl::clock::core<mcutl::clock::required_frequency<8_MHz>>,
+	mcutl::clock::force_skip_pll
+>;
+
+using profiles = mcutl::clock::clock_profile_set<full_speed_profile, medium_speed_profile, idle_profile>;
+
+using prescaled_ahb_profile = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::ahb<mcutl::clock::required_frequency<36_MHz>>
+>;
+
+using half_cycle_profile = mcutl::clock::config<
+	mcutl::clock::internal_high_speed_crystal,
+	mcutl::clock::core<mcutl::clock::required_frequency<8_MHz>>,
+	mcutl::clock::force_skip_pll,
+	mcutl::clock::enable_flash_half_cycle_access,
+	mcutl::clock::disable_flash_prefetch_buffer
+>;
+
+using flash_profiles = mcutl::clock::clock_profile_set<prescaled_ahb_profile, half_cycle_profile>;
+
+using timed_full_speed_profile = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::spi1<mcutl::clock::max_frequency<10_MHz>>,
+	mcutl::clock::timer2_3_4_5_6_7_12_13_14<mcutl::clock::required_frequency<72_MHz>>
+>;
+
+using timed_idle_profile = mcutl::clock::config<
+	mcutl::clock::internal_high_speed_crystal,
+	mcutl::clock::core<mcutl::clock::required_frequency<8_MHz>>,
+	mcutl::clock::spi1<mcutl::clock::max_frequency<10_MHz>>,
+	mcutl::clock::timer2_3_4_5_6_7_12_13_14<mcutl::clock::required_frequency<8_MHz>>,
+	mcutl::clock::force_skip_pll
+>;
+
+using timed_profiles = mcutl::clock::clock_profile_set<timed_full_speed_profile, timed_idle_profile>;
+
+using spi_prescaler = mcutl::spi::profile_prescaler<mcutl::spi::spi1, timed_profiles,
+	mcutl::clock::max_frequency<10_MHz>>;
+
+template<typename ClockConfig>
+using millisecond_tick = mcutl::timer::exact_overflow_frequency<ClockConfig, std::ratio<1000>>;
+using timer_timing = mcutl::timer::profile_timing<mcutl::timer::timer2, timed_profiles, millisecond_tick>;
+
+} //namespace
+
+class clock_profile_test_fixture : public mcutl::tests::mcu::flat_test_fixture_base
+{
+public:
+	virtual void SetUp() override
+	{
+		mcutl::tests::mcu::flat_test_fixture_base::SetUp();
+		rcc_ = std::make_unique<models::rcc_model>(memory(), 0);
+		memory().set(addr(&RCC->CR), RCC_CR_HSION | RCC_CR_HSIRDY);
+	}
+	
+	virtual void TearDown() override
+	{
+		rcc_.reset();
+		mcutl::tests::mcu::flat_test_fixture_base::TearDown();
+	}
+	
+	[[nodiscard]] uint64_t get_flash_latency()
+	{
+		return memory().get(addr(&FLASH->ACR)) & FLASH_ACR_LATENCY;
+	}
+	
+	[[nodiscard]] uint64_t get_sys_source()
+	{
+		return memory().get(addr(&RCC->CFGR)) & RCC_CFGR_SWS;
+	}
+	
+	//Returns the index of the first write to the register which satisfies the predicate
+	template<typename Predicate>
+	[[nodiscard]] size_t find_write(const mcutl::tests::memory::access_trace& trace,
+		const volatile void* reg, Predicate predicate)
+	{
+		const auto& records = trace.get_records();
+		auto it = std::find_if(records.begin(), records.end(), [this, reg, &predicate] (const auto& record) {
+			return record.is_write && record.address == addr(reg) && predicate(record.value);
+		});
+		return static_cast<size_t>(it - records.begin());
+	}
+	
+	//Checks that FLASH ACR is written only while AHB is not prescaled,
+	//returns the number of FLASH ACR writes
+	size_t expect_acr_writes_with_unprescaled_ahb(const mcutl::tests::memory::access_trace& trace,
+		uint64_t initial_cfgr)
+	{
+		size_t acr_write_count = 0;
+		uint64_t cfgr = initial_cfgr;
+		for (const auto& record : trace.get_records())
+		{
+			if (record.address == addr(&RCC->CFGR))
+			{
+				cfgr = record.value;
+			}
+			else if (record.is_write && record.address == addr(&FLASH->ACR))
+			{
+				EXPECT_EQ(cfgr & RCC_CFGR_HPRE, RCC_CFGR_HPRE_DIV1);
+				++acr_write_count;
+			}
+		}
+		return acr_write_count;
+	}
+
+private:
+	std::unique_ptr<models::rcc_model> rcc_;
+};
+
+TEST(clock_profile_set_test, ProfileTypesTest)
+{
+	static_assert(profiles::profile_count == 3u);
+	static_assert(std::is_same_v<profiles::profile_t<0>, full_speed_profile>);
+	static_assert(std::is_same_v<profiles::profile_t<2>, idle_profile>);
+	
+	constexpr profiles set(2);
+	static_assert(set.get_current_profile() == 2u);
+}
+
+TEST_F(clock_profile_test_fixture, ConfigureAndSwitchTest)
+{
+	profiles set;
+	set.configure<0>();
+	EXPECT_EQ(set.get_current_profile(), 0u);
+	EXPECT_EQ(get_sys_source(), RCC_CFGR_SWS_PLL);
+	EXPECT_EQ(get_flash_latency(), FLASH_ACR_LATENCY_1);
+	
+	set.switch_to(2);
+	EXPECT_EQ(set.get_current_profile(), 2u);
+	EXPECT_EQ(get_sys_source(), RCC_CFGR_SWS_HSI);
+	EXPECT_EQ(get_flash_latency(), 0u);
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_PLLON | RCC_CR_HSEON), 0u);
+	
+	set.switch_to<1>();
+	EXPECT_EQ(set.get_current_profile(), 1u);
+	EXPECT_EQ(get_sys_source(), RCC_CFGR_SWS_PLL);
+	EXPECT_EQ(get_flash_latency(), FLASH_ACR_LATENCY_0);
+	
+	set.switch_to(0);
+	EXPECT_EQ(get_sys_source(), RCC_CFGR_SWS_PLL);
+	EXPECT_EQ(get_flash_latency(), FLASH_ACR_LATENCY_1);
+}
+
+TEST_F(clock_profile_test_fixture, FlashLatencyOrderingTest)
+{
+	profiles set;
+	set.configure<2>();
+	
+	mcutl::tests::memory::access_trace trace;
+	set.switch_to(0);
+	//Flash latency must be increased before the system clock is switched to the faster source
+	auto latency_write = find_write(trace, &FLASH->ACR,
+		[] (uint64_t value) { return (value & FLASH_ACR_LATENCY) == FLASH_ACR_LATENCY_1; });
+	auto pll_switch_write = find_write(trace, &RCC->CFGR,
+		[] (uint64_t value) { return (value & RCC_CFGR_SW) == RCC_CFGR_SW_PLL; });
+	ASSERT_LT(pll_switch_write, trace.get_records().size());
+	EXPECT_LT(latency_write, pll_switch_write);
+	
+	trace.clear();
+	set.switch_to(2);
+	//Flash latency must be decreased after the system clock is switched to the slower source
+	latency_write = find_write(trace, &FLASH->ACR,
+		[] (uint64_t value) { return (value & FLASH_ACR_LATENCY) == 0u; });
+	auto hsi_switch_write = find_write(trace, &RCC->CFGR,
+		[] (uint64_t value) { return (value & RCC_CFGR_SW) == RCC_CFGR_SW_HSI; });
+	ASSERT_LT(latency_write, trace.get_records().size());
+	EXPECT_LT(hsi_switch_write, latency_write);
+}
+
+TEST_F(clock_profile_test_fixture, FlashPrefetchBufferSwitchTest)
+{
+	flash_profiles set;
+	set.configure<0>();
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	
+	mcutl::tests::memory::access_trace trace;
+	set.switch_to(1);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_HLFCYA);
+	//Prefetch buffer must be disabled when SYSCLK is running from HSI and AHB is not prescaled
+	auto acr_write = find_write(trace, &FLASH->ACR, [] (uint64_t) { return true; });
+	auto hsi_switch_write = find_write(trace, &RCC->CFGR,
+		[] (uint64_t value) { return (value & RCC_CFGR_SW) == RCC_CFGR_SW_HSI; });
+	auto ahb_write = find_write(trace, &RCC->CFGR,
+		[] (uint64_t value) { return (value & RCC_CFGR_HPRE) == RCC_CFGR_HPRE_DIV1; });
+	ASSERT_LT(acr_write, trace.get_records().size());
+	EXPECT_LT(hsi_switch_write, acr_write);
+	EXPECT_LT(ahb_write, acr_write);
+	
+	trace.clear();
+	set.switch_to(0);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	//Prefetch buffer must be enabled before AHB prescaler is applied
+	acr_write = find_write(trace, &FLASH->ACR, [] (uint64_t) { return true; });
+	ahb_write = find_write(trace, &RCC->CFGR,
+		[] (uint64_t value) { return (value & RCC_CFGR_HPRE) == RCC_CFGR_HPRE_DIV2; });
+	ASSERT_LT(ahb_write, trace.get_records().size());
+	EXPECT_LT(acr_write, ahb_write);
+}
+
+TEST_F(clock_profile_test_fixture, PrefetchBufferSwitchWithPrescaledAhbTest)
+{
+	//New configuration prescales AHB
+	mcutl::tests::memory::access_trace trace;
+	mcutl::clock::configure_clocks<prescaled_ahb_profile>();
+	EXPECT_EQ(expect_acr_writes_with_unprescaled_ahb(trace, 0), 1u);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_HPRE, RCC_CFGR_HPRE_DIV2);
+	
+	//Old configuration prescales AHB, prefetch buffer is disabled
+	memory().set(addr(&FLASH->ACR), FLASH_ACR_LATENCY_1);
+	auto initial_cfgr = memory().get(addr(&RCC->CFGR));
+	trace.clear();
+	mcutl::clock::configure_clocks<full_speed_profile>();
+	EXPECT_EQ(expect_acr_writes_with_unprescaled_ahb(trace, initial_cfgr), 1u);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_HPRE, RCC_CFGR_HPRE_DIV1);
+	
+	//Both configurations prescale AHB, clocks are started asynchronously
+	mcutl::clock::configure_clocks<prescaled_ahb_profile>();
+	memory().set(addr(&FLASH->ACR), FLASH_ACR_LATENCY_1);
+	initial_cfgr = memory().get(addr(&RCC->CFGR));
+	trace.clear();
+	auto startup = mcutl::clock::start_clocks<prescaled_ahb_profile>();
+	startup.complete();
+	EXPECT_EQ(expect_acr_writes_with_unprescaled_ahb(trace, initial_cfgr), 1u);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_HPRE, RCC_CFGR_HPRE_DIV2);
+}
+
+TEST_F(clock_profile_test_fixture, NoAccessesForSameOrInvalidProfileTest)
+{
+	profiles set(1);
+	mcutl::tests::memory::access_counter counter;
+	EXPECT_EQ(counter.measure("same", [&set] { set.switch_to(1); }),
+		(mcutl::tests::memory::access_count{ 0u, 0u }));
+	EXPECT_EQ(counter.measure("invalid", [&set] { set.switch_to(profiles::profile_count); }),
+		(mcutl::tests::memory::access_count{ 0u, 0u }));
+	EXPECT_EQ(set.get_current_profile(), 1u);
+}
+
+TEST(clock_profile_set_test, PeripheralTimingTablesTest)
+{
+	for (size_t profile = 0; profile != timed_profiles::profile_count; ++profile)
+	{
+		EXPECT_LE(spi_prescaler::get_input_frequency(profile) / spi_prescaler::get_prescaler(profile), 10_MHz);
+		EXPECT_GE(spi_prescaler::get_input_frequency(profile) / spi_prescaler::get_prescaler(profile), 4_MHz);
+		EXPECT_EQ(timer_timing::get_input_frequency(profile)
+			/ timer_timing::get_prescaler(profile) / timer_timing::get_reload_value(profile), 1000u);
+	}
+	
+	static_assert(spi_prescaler::get_prescaler(0) == 8u);
+	static_assert(spi_prescaler::get_prescaler(1) == 2u);
+	static_assert(timer_timing::get_input_frequency(0) == 72_MHz);
+	static_assert(timer_timing::get_input_frequency(1) == 8_MHz);
+}
+
+TEST_F(clock_profile_test_fixture, RetimePeripheralsTest)
+{
+	mcutl::tests::memory::access_counter counter;
+	auto count = counter.measure("retime", [] {
+		mcutl::clock::retime_peripherals<spi_prescaler, timer_timing>(1);
+	});
+	//SPI CR1 read-modify-write, timer PSC, ARR and EGR writes
+	EXPECT_EQ(count, (mcutl::tests::memory::access_count{ 1u, 4u }));
+	EXPECT_EQ(memory().get(addr(&SPI1->CR1)) & SPI_CR1_BR, 0u);
+	EXPECT_EQ(memory().get(addr(&TIM2->PSC)) + 1u, timer_timing::get_prescaler(1));
+	EXPECT_EQ(memory().get(addr(&TIM2->ARR)) + 1u, timer_timing::get_reload_value(1));
+	EXPECT_EQ(memory().get(addr(&TIM2->EGR)), TIM_EGR_UG);
+}
+
+TEST_F(clock_profile_test_fixture, RetimeTimerUpdateEventTest)
+{
+	mcutl::tests::memory::access_trace trace;
+	timer_timing::retime(0);
+	
+	//The prescaler is buffered, so the update event must be generated after it is written
+	auto psc_write = find_write(trace, &TIM2->PSC, [] (uint64_t) { return true; });
+	auto arr_write = find_write(trace, &TIM2->ARR, [] (uint64_t) { return true; });
+	auto egr_write = find_write(trace, &TIM2->EGR,
+		[] (uint64_t value) { return value == TIM_EGR_UG; });
+	ASSERT_LT(egr_write, trace.get_records().size());
+	EXPECT_LT(psc_write, egr_write);
+	EXPECT_LT(arr_write, egr_write);
+}
+
+TEST_F(clock_profile_test_fixture, SwitchAndRetimeOrderingTest)
+{
+	timed_profiles set;
+	set.configure<1>();
+	mcutl::clock::retime_peripherals<spi_prescaler, timer_timing>(1);
+	
+	mcutl::tests::memory::access_trace trace;
+	set.switch_to_and_retime<spi_prescaler, timer_timing>(0);
+	EXPECT_EQ(set.get_current_profile(), 0u);
+	EXPECT_EQ(get_sys_source(), RCC_CFGR_SWS_PLL);
+	EXPECT_EQ(memory().get(addr(&SPI1->CR1)) & SPI_CR1_BR, SPI_CR1_BR_1);
+	EXPECT_EQ(memory().get(addr(&TIM2->PSC)) + 1u, timer_timing::get_prescaler(0));
+	EXPECT_EQ(memory().get(addr(&TIM2->ARR)) + 1u, timer_timing::get_reload_value(0));
+	
+	//Peripheral clocks become faster, so the peripherals are retimed before the switch
+	auto spi_write = find_write(trace, &SPI1->CR1, [] (uint64_t) { return true; });
+	auto pll_switch_write = find_write(trace, &RCC->CFGR,
+		[] (uint64_t value) { return (value & RCC_CFGR_SW) == RCC_CFGR_SW_PLL; });
+	ASSERT_LT(pll_switch_write, trace.get_records().size());
+	EXPECT_LT(spi_write, pll_switch_write);
+	
+	trace.clear();
+	set.switch_to_and_retime<1, spi_prescaler, timer_timing>();
+	EXPECT_EQ(get_sys_source(), RCC_CFGR_SWS_HSI);
+	EXPECT_EQ(memory().get(addr(&SPI1->CR1)) & SPI_CR1_BR, 0u);
+	
+	//Peripheral clocks become slower, so the peripherals are retimed after the switch
+	spi_write = find_write(trace, &SPI1->CR1, [] (uint64_t) { return true; });
+	auto hsi_switch_write = find_write(trace, &RCC->CFGR,
+		[] (uint64_t value) { return (value & RCC_CFGR_SW) == RCC_CFGR_SW_HSI; });
+	ASSERT_LT(spi_write, trace.get_records().size());
+	EXPECT_LT(hsi_switch_write, spi_write);
+}
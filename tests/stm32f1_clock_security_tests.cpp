@@ -0,0 +1,189 @@
+#define STM32F103xB
+#define STM32F1
+
+#include <memory>
+#include <stdint.h>
+
+#include "mcutl/clock/clock.h"
+#include "mcutl/tests/access_trace.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/tests/stm32f1_peripheral_models.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+using namespace mcutl::clock::literals;
+namespace models = mcutl::tests::memory::stm32f1;
+
+namespace
+{
+
+constexpr uint32_t oscillator_delay = 3;
+
+using protected_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::spi1<mcutl::clock::max_frequency<10_MHz>>,
+	mcutl::clock::timer2_3_4_5_6_7_12_13_14<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::enable_clock_security_system
+>;
+
+using unprotected_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::spi1<mcutl::clock::max_frequency<10_MHz>>,
+	mcutl::clock::timer2_3_4_5_6_7_12_13_14<mcutl::clock::required_frequency<72_MHz>>
+>;
+
+using protected_usb_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::provide_usb_frequency,
+	mcutl::clock::enable_clock_security_system
+>;
+
+using protected_prescaled_ahb_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::ahb<mcutl::clock::required_frequency<36_MHz>>,
+	mcutl::clock::enable_clock_security_system
+>;
+
+using fallback_config = mcutl::clock::hse_failure_fallback_config_t<protected_config>;
+using usb_fallback_config = mcutl::clock::hse_failure_fallback_config_t<protected_usb_config>;
+
+template<typename ClockConfig>
+constexpr uint64_t get_frequency(mcutl::clock::clock_id id) noexcept
+{
+	return mcutl::clock::get_best_clock_tree<ClockConfig>().get_config_by_id(id).get_exact_frequency();
+}
+
+} //namespace
+
+TEST(clock_security_test, FallbackConfigTest)
+{
+	using mcutl::clock::clock_id;
+	
+	static_assert(get_frequency<protected_config>(clock_id::sys) == 72_MHz);
+	static_assert(get_frequency<protected_config>(clock_id::spi1) == 9_MHz);
+	static_assert(get_frequency<protected_config>(clock_id::timer2_3_4_5_6_7_12_13_14) == 72_MHz);
+	
+	EXPECT_EQ((mcutl::clock::get_clock_info<fallback_config, clock_id::hsi>().get_exact_frequency()), 8_MHz);
+	EXPECT_EQ((mcutl::clock::get_clock_info<fallback_config, clock_id::sys>().get_exact_frequency()), 64_MHz);
+	EXPECT_EQ((mcutl::clock::get_clock_info<fallback_config, clock_id::apb1>().get_exact_frequency()), 32_MHz);
+	EXPECT_EQ((mcutl::clock::get_clock_info<fallback_config, clock_id::spi1>().get_exact_frequency()), 8_MHz);
+	EXPECT_EQ((mcutl::clock::get_clock_info<fallback_config,
+		clock_id::timer2_3_4_5_6_7_12_13_14>().get_exact_frequency()), 64_MHz);
+	
+	EXPECT_EQ((mcutl::clock::get_clock_info<usb_fallback_config, clock_id::sys>().get_exact_frequency()), 48_MHz);
+	EXPECT_EQ((mcutl::clock::get_clock_info<usb_fallback_config, clock_id::usb>().get_exact_frequency()), 48_MHz);
+}
+
+class clock_security_test_fixture : public mcutl::tests::mcu::flat_test_fixture_base
+{
+public:
+	virtual void SetUp() override
+	{
+		mcutl::tests::mcu::flat_test_fixture_base::SetUp();
+		memory().set(addr(&RCC->CR), RCC_CR_HSION | RCC_CR_HSIRDY);
+		rcc_ = std::make_unique<models::rcc_model>(memory(), oscillator_delay);
+	}
+	
+	virtual void TearDown() override
+	{
+		rcc_.reset();
+		mcutl::tests::mcu::flat_test_fixture_base::TearDown();
+	}
+	
+	//Emulates the hardware reaction to an HSE failure: HSE and the PLL clocked by it
+	//are stopped, SYSCLK is switched to HSI and the CSS interrupt flag is set
+	void fail_hse()
+	{
+		memory().get(addr(&RCC->CR)) &= ~static_cast<uint64_t>(RCC_CR_HSEON | RCC_CR_HSERDY
+			| RCC_CR_PLLON | RCC_CR_PLLRDY);
+		memory().get(addr(&RCC->CR)) |= RCC_CR_HSION | RCC_CR_HSIRDY;
+		memory().get(addr(&RCC->CFGR)) &= ~static_cast<uint64_t>(RCC_CFGR_SW | RCC_CFGR_SWS);
+		memory().get(addr(&RCC->CIR)) |= RCC_CIR_CSSF;
+	}
+
+private:
+	std::unique_ptr<models::rcc_model> rcc_;
+};
+
+TEST_F(clock_security_test_fixture, ConfigureEnablesClockSecuritySystemTest)
+{
+	mcutl::clock::configure_clocks<protected_config>();
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_HSEON | RCC_CR_CSSON),
+		RCC_CR_HSEON | RCC_CR_CSSON);
+	
+	mcutl::clock::reconfigure_clocks<protected_config, unprotected_config>();
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_HSEON | RCC_CR_CSSON), RCC_CR_HSEON);
+	
+	mcutl::clock::reconfigure_clocks<unprotected_config, protected_config>();
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_HSEON | RCC_CR_CSSON),
+		RCC_CR_HSEON | RCC_CR_CSSON);
+}
+
+TEST_F(clock_security_test_fixture, SwitchToFallbackTest)
+{
+	mcutl::clock::configure_clocks<protected_config>();
+	EXPECT_FALSE(mcutl::clock::is_hse_failure_detected());
+	
+	fail_hse();
+	EXPECT_TRUE(mcutl::clock::is_hse_failure_detected());
+	mcutl::clock::switch_to_hse_failure_fallback<protected_config>();
+	EXPECT_FALSE(mcutl::clock::is_hse_failure_detected());
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_HSEON | RCC_CR_CSSON | RCC_CR_PLLON | RCC_CR_PLLRDY),
+		RCC_CR_PLLON | RCC_CR_PLLRDY);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & (RCC_CFGR_SWS | RCC_CFGR_PLLSRC | RCC_CFGR_PLLMULL
+		| RCC_CFGR_PPRE1 | RCC_CFGR_PPRE2 | RCC_CFGR_HPRE),
+		RCC_CFGR_SWS_PLL | RCC_CFGR_PLLMULL16 | RCC_CFGR_PPRE1_DIV2);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	EXPECT_EQ(memory().get(addr(&SPI1->CR1)) & SPI_CR1_BR, SPI_CR1_BR_1);
+}
+
+TEST_F(clock_security_test_fixture, SwitchToFallbackReenablesUsbTest)
+{
+	mcutl::clock::configure_clocks<protected_usb_config>();
+	memory().get(addr(&RCC->APB1ENR)) |= RCC_APB1ENR_USBEN;
+	
+	fail_hse();
+	mcutl::clock::switch_to_hse_failure_fallback<protected_usb_config>();
+	
+	EXPECT_EQ(memory().get(addr(&RCC->APB1ENR)) & RCC_APB1ENR_USBEN, RCC_APB1ENR_USBEN);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & (RCC_CFGR_SWS | RCC_CFGR_PLLSRC
+		| RCC_CFGR_PLLMULL | RCC_CFGR_USBPRE),
+		RCC_CFGR_SWS_PLL | RCC_CFGR_PLLMULL12 | RCC_CFGR_USBPRE);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_0 | FLASH_ACR_PRFTBE);
+}
+
+TEST_F(clock_security_test_fixture, SwitchToFallbackWithPrescaledAhbTest)
+{
+	mcutl::clock::configure_clocks<protected_prescaled_ahb_config>();
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_HPRE, RCC_CFGR_HPRE_DIV2);
+	memory().set(addr(&FLASH->ACR), FLASH_ACR_LATENCY_1);
+	
+	fail_hse();
+	auto cfgr = memory().get(addr(&RCC->CFGR));
+	mcutl::tests::memory::access_trace trace;
+	mcutl::clock::switch_to_hse_failure_fallback<protected_prescaled_ahb_config>();
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & (RCC_CFGR_SWS | RCC_CFGR_HPRE),
+		RCC_CFGR_SWS_PLL | RCC_CFGR_HPRE_DIV2);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	
+	//The prefetch buffer can only be switched when AHB is not prescaled
+	size_t acr_write_count = 0;
+	for (const auto& record : trace.get_records())
+	{
+		if (record.address == addr(&RCC->CFGR))
+		{
+			cfgr = record.value;
+		}
+		else if (record.is_write && record.address == addr(&FLASH->ACR))
+		{
+			EXPECT_EQ(cfgr & RCC_CFGR_HPRE, RCC_CFGR_HPRE_DIV1);
+			++acr_write_count;
+		}
+	}
+	EXPECT_EQ(acr_write_count, 1u);
+}
@@ -0,0 +1,159 @@
+#define STM32F103xB
+#define STM32F1
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+#include "mcutl/clock/clock.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/tests/stm32f1_peripheral_models.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+using namespace mcutl::clock::literals;
+namespace models = mcutl::tests::memory::stm32f1;
+
+namespace
+{
+
+constexpr uint32_t oscillator_delay = 3;
+
+using external_pll_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::base_configuration_is_currently_present
+>;
+
+using internal_pll_config = mcutl::clock::config<
+	mcutl::clock::internal_high_speed_crystal,
+	mcutl::clock::core<mcutl::clock::required_frequency<48_MHz>>,
+	mcutl::clock::provide_usb_frequency,
+	mcutl::clock::base_configuration_is_currently_present
+>;
+
+using external_no_pll_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::force_skip_pll,
+	mcutl::clock::spi1<mcutl::clock::max_frequency<1_MHz>>,
+	mcutl::clock::base_configuration_is_currently_present
+>;
+
+using unknown_state_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+	mcutl::clock::provide_usb_frequency
+>;
+
+} //namespace
+
+class clock_startup_test_fixture : public mcutl::tests::mcu::flat_test_fixture_base
+{
+public:
+	virtual void SetUp() override
+	{
+		mcutl::tests::mcu::flat_test_fixture_base::SetUp();
+		reset_memory();
+	}
+	
+	virtual void TearDown() override
+	{
+		rcc_.reset();
+		mcutl::tests::mcu::flat_test_fixture_base::TearDown();
+	}
+	
+	void reset_memory()
+	{
+		rcc_.reset();
+		for (auto reg : { addr(&RCC->CR), addr(&RCC->CFGR), addr(&RCC->APB1ENR),
+			addr(&FLASH->ACR), addr(&SPI1->CR1) })
+		{
+			memory().set(reg, 0);
+		}
+		memory().set(addr(&RCC->CR), RCC_CR_HSION | RCC_CR_HSIRDY);
+		rcc_ = std::make_unique<models::rcc_model>(memory(), oscillator_delay);
+	}
+	
+	//Returns RCC CR, RCC CFGR, RCC APB1ENR, FLASH ACR and SPI1 CR1 values
+	[[nodiscard]] std::vector<uint64_t> get_clock_registers()
+	{
+		return { memory().get(addr(&RCC->CR)), memory().get(addr(&RCC->CFGR)),
+			memory().get(addr(&RCC->APB1ENR)), memory().get(addr(&FLASH->ACR)),
+			memory().get(addr(&SPI1->CR1)) };
+	}
+	
+	//Checks that the clock registers are the same after start_clocks() and configure_clocks()
+	template<typename ClockConfig>
+	void expect_same_as_configure_clocks()
+	{
+		reset_memory();
+		mcutl::clock::configure_clocks<ClockConfig>();
+		auto expected = get_clock_registers();
+		
+		reset_memory();
+		auto startup = mcutl::clock::start_clocks<ClockConfig>();
+		startup.complete();
+		EXPECT_TRUE(startup.is_complete());
+		EXPECT_EQ(get_clock_registers(), expected);
+	}
+
+private:
+	std::unique_ptr<models::rcc_model> rcc_;
+};
+
+TEST_F(clock_startup_test_fixture, StartDoesNotWaitForOscillatorsTest)
+{
+	auto startup = mcutl::clock::start_clocks<external_pll_config>();
+	EXPECT_FALSE(startup.is_complete());
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_HSEON | RCC_CR_HSERDY | RCC_CR_PLLON),
+		RCC_CR_HSEON);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_SWS, RCC_CFGR_SWS_HSI);
+	
+	uint32_t poll_count = 0;
+	while (!startup.poll())
+		++poll_count;
+	
+	//HSE ready, PLL ready and system clock switch
+	EXPECT_EQ(poll_count, 3 * oscillator_delay - 1);
+	EXPECT_TRUE(startup.is_complete());
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_SWS, RCC_CFGR_SWS_PLL);
+	EXPECT_EQ(memory().get(addr(&FLASH->ACR)), FLASH_ACR_LATENCY_1 | FLASH_ACR_PRFTBE);
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & RCC_CR_HSION, 0u);
+	
+	//Polling a completed startup does nothing
+	EXPECT_TRUE(startup.poll());
+}
+
+TEST_F(clock_startup_test_fixture, StartEnablesInternalOscillatorPllTest)
+{
+	auto startup = mcutl::clock::start_clocks<internal_pll_config>();
+	EXPECT_FALSE(startup.is_complete());
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_HSEON | RCC_CR_PLLON), RCC_CR_PLLON);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_PLLMULL, RCC_CFGR_PLLMULL12);
+	
+	startup.complete();
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_SWS, RCC_CFGR_SWS_PLL);
+}
+
+TEST_F(clock_startup_test_fixture, SameAsConfigureClocksTest)
+{
+	expect_same_as_configure_clocks<external_pll_config>();
+	expect_same_as_configure_clocks<internal_pll_config>();
+	expect_same_as_configure_clocks<external_no_pll_config>();
+}
+
+TEST_F(clock_startup_test_fixture, UnknownInitialStateTest)
+{
+	memory().set(addr(&RCC->APB1ENR), RCC_APB1ENR_USBEN);
+	mcutl::clock::configure_clocks<unknown_state_config>();
+	auto expected = get_clock_registers();
+	EXPECT_EQ(memory().get(addr(&RCC->APB1ENR)), RCC_APB1ENR_USBEN);
+	
+	//Start from the configured state with USB enabled, USB must be re-enabled after the switch
+	auto startup = mcutl::clock::start_clocks<unknown_state_config>();
+	EXPECT_EQ(memory().get(addr(&RCC->APB1ENR)), 0u);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_SWS, RCC_CFGR_SWS_HSI);
+	startup.complete();
+	EXPECT_EQ(get_clock_registers(), expected);
+}
@@ -63,6 +63,26 @@ TEST_F(dma_strict_test_fixture, StartTransferMemToPeriphTest)
 	mcutl::dma::start_transfer<mcutl::dma::dma2<3>>(from_address, to_address, transfer_size);
 }
 
+TEST_F(dma_strict_test_fixture, StartTransferDisabledChannelTest)
+{
+	uint32_t initial_ccr = DMA_CCR_MINC | DMA_CCR_TCIE;
+	memory().set(addr(&DMA1_Channel2->CCR), initial_ccr);
+	memory().allow_reads(addr(&DMA1_Channel2->CCR));
+	
+	::testing::InSequence s;
+	EXPECT_CALL(memory(), write(addr(&DMA1_Channel2->CCR), initial_ccr));
+	EXPECT_CALL(memory(), write(addr(&DMA1_Channel2->CPAR),
+		mcutl::memory::to_address(from_address)));
+	EXPECT_CALL(memory(), write(addr(&DMA1_Channel2->CMAR),
+		mcutl::memory::to_address(to_address)));
+	EXPECT_CALL(memory(), write(addr(&DMA1_Channel2->CNDTR), transfer_size));
+	EXPECT_CALL(instruction(), run(instr<mcutl::device::instruction::type::dmb>(),
+		::testing::IsEmpty()));
+	EXPECT_CALL(memory(), write(addr(&DMA1_Channel2->CCR), initial_ccr | DMA_CCR_EN));
+	
+	mcutl::dma::start_transfer<mcutl::dma::dma1<2>>(from_address, to_address, transfer_size);
+}
+
 TEST_F(dma_strict_test_fixture, WaitTransferEnabledTest)
 {
 	uint32_t initial_ccr = DMA_CCR_EN | 0x12345678u;
@@ -150,6 +170,41 @@ TEST_F(dma_strict_test_fixture, ClearPendingFlagsMaskAtomicTest)
 		mcutl::dma::interrupt::transfer_complete>();
 }
 
+TEST_F(dma_strict_test_fixture, PendingFlagsTest)
+{
+	EXPECT_EQ((mcutl::dma::pending_flags_v<mcutl::dma::dma1<2>,
+		mcutl::dma::interrupt::half_transfer,
+		mcutl::dma::interrupt::transfer_complete>), DMA_ISR_HTIF2 | DMA_ISR_TCIF2);
+	EXPECT_EQ((mcutl::dma::pending_flags_v<mcutl::dma::dma2<5>,
+		mcutl::dma::interrupt::transfer_error>), DMA_ISR_TEIF5);
+	EXPECT_EQ(mcutl::dma::pending_flags_v<mcutl::dma::dma1<1>>, 0u);
+}
+
+TEST_F(dma_strict_test_fixture, GetPendingFlagsTest)
+{
+	memory().allow_reads(addr(&DMA1->ISR));
+	memory().allow_reads(addr(&DMA2->ISR));
+	memory().set(addr(&DMA1->ISR), DMA_ISR_GIF3 | DMA_ISR_HTIF3 | DMA_ISR_TCIF4);
+	memory().set(addr(&DMA2->ISR), DMA_ISR_TEIF1);
+	
+	EXPECT_EQ((mcutl::dma::get_pending_flags<mcutl::dma::dma1<3>,
+		mcutl::dma::interrupt::half_transfer,
+		mcutl::dma::interrupt::transfer_complete>()), DMA_ISR_HTIF3);
+	EXPECT_EQ((mcutl::dma::get_pending_flags<mcutl::dma::dma1<4>,
+		mcutl::dma::interrupt::transfer_complete>()), DMA_ISR_TCIF4);
+	EXPECT_EQ((mcutl::dma::get_pending_flags<mcutl::dma::dma2<1>,
+		mcutl::dma::interrupt::transfer_error>()), DMA_ISR_TEIF1);
+	EXPECT_EQ((mcutl::dma::get_pending_flags<mcutl::dma::dma2<1>>()), 0u);
+}
+
+TEST_F(dma_strict_test_fixture, GetRemainingTransfersTest)
+{
+	memory().allow_reads(addr(&DMA1_Channel6->CNDTR));
+	memory().set(addr(&DMA1_Channel6->CNDTR), 123u);
+	
+	EXPECT_EQ(mcutl::dma::get_remaining_transfers<mcutl::dma::dma1<6>>(), 123u);
+}
+
 TEST_F(dma_strict_test_fixture, ComplexConfigureEnableInterruptTest)
 {
 	expect_configure(DMA2_Channel3_BASE, DMA_CCR_DIR | DMA_CCR_PL_1 | DMA_CCR_TCIE
@@ -0,0 +1,69 @@
+#define STM32F103xG
+#define STM32F1
+
+#include <ratio>
+#include <stdint.h>
+#include <type_traits>
+
+#include "mcutl/dma/dma.h"
+#include "mcutl/gpio/gpio_sampler.h"
+#include "mcutl/interrupt/interrupt.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/timer/timer.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "stm32f1_gpio_timer_dma_test_fixture.h"
+
+namespace
+{
+
+using sampler = mcutl::gpio::port_sampler<'b', mcutl::timer::timer2,
+	mcutl::dma::interrupt::half_transfer,
+	mcutl::dma::interrupt::transfer_complete>;
+
+constexpr uint32_t sample_count = 64u;
+
+} //namespace
+
+class gpio_sampler_test_fixture
+	: public gpio_timer_dma_test_fixture<sampler, std::ratio<1'000'000>, uint16_t, sample_count>
+{
+};
+
+TEST(gpio_sampler_test, TraitsTest)
+{
+	EXPECT_TRUE((std::is_same_v<sampler::dma_channel, mcutl::dma::dma1<2>>));
+	EXPECT_TRUE((std::is_same_v<sampler::timer, mcutl::timer::timer2>));
+	EXPECT_TRUE((std::is_same_v<sampler::sample_type, uint16_t>));
+	EXPECT_EQ(sampler::port_letter, 'b');
+}
+
+TEST_F(gpio_sampler_test_fixture, ConfigureTest)
+{
+	configure();
+	
+	EXPECT_EQ(memory().get(addr(&TIM2->PSC)), 0u);
+	EXPECT_EQ(memory().get(addr(&TIM2->ARR)), 71u);
+	EXPECT_EQ(memory().get(addr(&TIM2->DIER)), TIM_DIER_UDE);
+	EXPECT_EQ(memory().get(addr(&TIM2->CR1)) & TIM_CR1_CEN, 0u);
+	EXPECT_EQ(memory().get(addr(&DMA1_Channel2->CCR)), DMA_CCR_CIRC | DMA_CCR_MINC
+		| DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 | DMA_CCR_HTIE | DMA_CCR_TCIE);
+}
+
+TEST_F(gpio_sampler_test_fixture, StartStopTest)
+{
+	configure();
+	sampler::start(buffer.data(), sample_count);
+	expect_started(DMA1_Channel2, TIM2, addr(&GPIOB->IDR));
+	
+	EXPECT_EQ(sampler::get_write_position(sample_count), 0u);
+	memory().set(addr(&DMA1_Channel2->CNDTR), sample_count - 10u);
+	EXPECT_EQ(sampler::get_write_position(sample_count), 10u);
+	
+	sampler::stop();
+	expect_stopped(DMA1_Channel2, TIM2);
+	EXPECT_EQ(memory().get(addr(&DMA1_Channel2->CCR)), DMA_CCR_CIRC | DMA_CCR_MINC
+		| DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 | DMA_CCR_HTIE | DMA_CCR_TCIE);
+}
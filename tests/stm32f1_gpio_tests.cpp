@@ -1,6 +1,7 @@
 #define STM32F103xE
 #define STM32F1
 
+#include <iterator>
 #include <type_traits>
 
 #include "mcutl/exti/exti.h"
@@ -124,6 +125,203 @@ TEST_F(gpio_strict_test_fixture, EnableGpioAfioPeripheralsTest)
 	>();
 }
 
+TEST_F(gpio_strict_test_fixture, InitTableGpioConfigTest)
+{
+	constexpr auto table = mcutl::gpio::get_init_table<
+		mcutl::gpio::to_value<mcutl::gpio::gpiob<1>, mcutl::gpio::out::one>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<3>, mcutl::gpio::out::open_drain>,
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<14>, mcutl::gpio::in::pull_down>,
+		mcutl::gpio::connect_to_exti_line<mcutl::gpio::gpiob<11>>,
+		mcutl::gpio::enable_peripherals
+	>();
+	static_assert(table.size() == 7u);
+	
+	::testing::InSequence s;
+	
+	constexpr uint32_t initial_cr_value = 0xffffffffu;
+	memory().set(addr(&GPIOA->CRL), initial_cr_value);
+	memory().set(addr(&GPIOA->CRH), initial_cr_value);
+	
+	EXPECT_CALL(memory(), read(addr(&RCC->APB2ENR)));
+	EXPECT_CALL(memory(), write(addr(&RCC->APB2ENR),
+		RCC_APB2ENR_IOPAEN | RCC_APB2ENR_IOPBEN | RCC_APB2ENR_AFIOEN));
+	EXPECT_CALL(memory(), read(addr(&RCC->APB2ENR)));
+	
+	EXPECT_CALL(memory(), read(addr(&(AFIO->EXTICR[2]))));
+	EXPECT_CALL(memory(), write(addr(&(AFIO->EXTICR[2])), AFIO_EXTICR3_EXTI11_PB));
+	
+	EXPECT_CALL(memory(), read(addr(&GPIOA->CRL)));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->CRL),
+		(initial_cr_value & ~(GPIO_CRL_CNF3 | GPIO_CRL_MODE3))
+		| GPIO_CRL_CNF3_0 | GPIO_CRL_MODE3_0 | GPIO_CRL_MODE3_1));
+	EXPECT_CALL(memory(), read(addr(&GPIOA->CRH)));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->CRH),
+		(initial_cr_value & ~(GPIO_CRH_CNF14 | GPIO_CRH_MODE14)) | GPIO_CRH_CNF14_1));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->BSRR), GPIO_BSRR_BR14));
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOB->BSRR), GPIO_BSRR_BS1));
+	
+	mcutl::memory::apply_init_table(table);
+}
+
+TEST_F(gpio_strict_test_fixture, MergedConfigTest)
+{
+	using spi_pins = mcutl::gpio::config<
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<5>, mcutl::gpio::out::push_pull_alt_func>,
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<6>, mcutl::gpio::in::floating>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<7>, mcutl::gpio::out::push_pull_alt_func>,
+		mcutl::gpio::enable_peripherals
+	>;
+	using led_pins = mcutl::gpio::config<
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<1>, mcutl::gpio::out::push_pull, mcutl::gpio::out::one>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<9>, mcutl::gpio::out::push_pull, mcutl::gpio::out::zero>,
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<6>, mcutl::gpio::in::floating>,
+		mcutl::gpio::enable_peripherals
+	>;
+	using button_pin = mcutl::gpio::as_input<mcutl::gpio::gpioa<0>, mcutl::gpio::in::pull_up>;
+	using merged = mcutl::gpio::merged_config<spi_pins, led_pins, button_pin>;
+	
+	static_assert(std::is_same_v<merged, mcutl::gpio::config<
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<5>, mcutl::gpio::out::push_pull_alt_func>,
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<6>, mcutl::gpio::in::floating>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<7>, mcutl::gpio::out::push_pull_alt_func>,
+		mcutl::gpio::enable_peripherals,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<1>, mcutl::gpio::out::push_pull, mcutl::gpio::out::one>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<9>, mcutl::gpio::out::push_pull, mcutl::gpio::out::zero>,
+		button_pin
+	>>);
+	static_assert(std::is_same_v<mcutl::gpio::merged_config<spi_pins, spi_pins>, spi_pins>);
+	static_assert(mcutl::gpio::configure_gpio_cost_v<merged>.accesses()
+		< (mcutl::gpio::configure_gpio_cost_v<spi_pins> + mcutl::gpio::configure_gpio_cost_v<led_pins>
+			+ mcutl::gpio::configure_gpio_cost_v<button_pin>).accesses());
+	
+	::testing::InSequence s;
+	
+	constexpr uint32_t initial_cr_value = 0xffffffffu;
+	memory().set(addr(&GPIOA->CRL), initial_cr_value);
+	memory().set(addr(&GPIOA->CRH), initial_cr_value);
+	
+	EXPECT_CALL(memory(), read(addr(&RCC->APB2ENR)));
+	EXPECT_CALL(memory(), write(addr(&RCC->APB2ENR), RCC_APB2ENR_IOPAEN));
+	EXPECT_CALL(memory(), read(addr(&RCC->APB2ENR)));
+	
+	constexpr uint32_t gpioa_crl_value
+		= GPIO_CRL_CNF0_1 //0 - in, pull up
+		| GPIO_CRL_MODE1_0 | GPIO_CRL_MODE1_1 //1 - out, push-pull, 50MHz
+		| GPIO_CRL_CNF5_1 | GPIO_CRL_MODE5_0 | GPIO_CRL_MODE5_1 //5 - out, push-pull alt, 50MHz
+		| GPIO_CRL_CNF6_0 //6 - in, floating
+		| GPIO_CRL_CNF7_1 | GPIO_CRL_MODE7_0 | GPIO_CRL_MODE7_1; //7 - out, push-pull alt, 50MHz
+	constexpr uint32_t gpioa_crl_mask
+		= GPIO_CRL_CNF0 | GPIO_CRL_MODE0
+		| GPIO_CRL_CNF1 | GPIO_CRL_MODE1
+		| GPIO_CRL_CNF5 | GPIO_CRL_MODE5
+		| GPIO_CRL_CNF6 | GPIO_CRL_MODE6
+		| GPIO_CRL_CNF7 | GPIO_CRL_MODE7;
+	
+	EXPECT_CALL(memory(), read(addr(&GPIOA->CRL)));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->CRL),
+		(initial_cr_value & ~gpioa_crl_mask) | gpioa_crl_value));
+	EXPECT_CALL(memory(), read(addr(&GPIOA->CRH)));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->CRH),
+		(initial_cr_value & ~(GPIO_CRH_CNF9 | GPIO_CRH_MODE9)) | GPIO_CRH_MODE9_0 | GPIO_CRH_MODE9_1));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->BSRR), GPIO_BSRR_BR9 | GPIO_BSRR_BS0 | GPIO_BSRR_BS1));
+	
+	mcutl::gpio::configure_gpio<merged>();
+}
+
+TEST_F(gpio_strict_test_fixture, TransitionTest)
+{
+	using open_drain_out = mcutl::gpio::config<
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<3>, mcutl::gpio::out::open_drain, mcutl::gpio::out::one>,
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<9>, mcutl::gpio::in::floating>
+	>;
+	using pull_up_in = mcutl::gpio::config<
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<3>, mcutl::gpio::in::pull_up>,
+		mcutl::gpio::as_input<mcutl::gpio::gpioa<9>, mcutl::gpio::in::floating>
+	>;
+	
+	static_assert(mcutl::gpio::transition_cost_v<open_drain_out, pull_up_in>
+		== mcutl::memory::bus_cost { 1u, 1u, 0u });
+	static_assert(mcutl::gpio::transition_cost_v<open_drain_out, open_drain_out>
+		== mcutl::memory::bus_cost {});
+	static_assert(mcutl::gpio::transition_cost_v<open_drain_out, pull_up_in>.accesses()
+		< mcutl::gpio::configure_gpio_cost_v<pull_up_in>.accesses());
+	
+	::testing::InSequence s;
+	
+	constexpr uint32_t initial_cr_value = 0xffffffffu;
+	memory().set(addr(&GPIOA->CRL), initial_cr_value);
+	
+	EXPECT_CALL(memory(), read(addr(&GPIOA->CRL)));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->CRL),
+		(initial_cr_value & ~(GPIO_CRL_CNF3 | GPIO_CRL_MODE3)) | GPIO_CRL_CNF3_1));
+	mcutl::gpio::transition<open_drain_out, pull_up_in>();
+	
+	mcutl::gpio::transition<open_drain_out, open_drain_out>();
+	
+	memory().set(addr(&GPIOA->CRL), initial_cr_value);
+	EXPECT_CALL(memory(), read(addr(&GPIOA->CRL)));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->CRL),
+		(initial_cr_value & ~(GPIO_CRL_CNF3 | GPIO_CRL_MODE3))
+		| GPIO_CRL_CNF3_0 | GPIO_CRL_MODE3_0 | GPIO_CRL_MODE3_1));
+	EXPECT_CALL(memory(), write(addr(&GPIOA->BSRR), GPIO_BSRR_BS3));
+	mcutl::gpio::transition<mcutl::gpio::as_input<mcutl::gpio::gpioa<3>, mcutl::gpio::in::pull_down>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<3>, mcutl::gpio::out::open_drain, mcutl::gpio::out::one>>();
+}
+
+TEST_F(gpio_strict_test_fixture, TransitionFullyKnownRegisterTest)
+{
+	using mcutl::gpio::gpiob;
+	using mcutl::gpio::as_input;
+	using mcutl::gpio::as_output;
+	namespace in = mcutl::gpio::in;
+	namespace out = mcutl::gpio::out;
+	
+	using from_config = mcutl::gpio::config<
+		as_output<gpiob<0>, out::push_pull, out::zero, out::opt::freq_2mhz>,
+		as_input<gpiob<1>, in::floating>, as_input<gpiob<2>, in::floating>,
+		as_input<gpiob<3>, in::floating>, as_input<gpiob<4>, in::floating>,
+		as_input<gpiob<5>, in::floating>, as_input<gpiob<6>, in::floating>,
+		as_input<gpiob<7>, in::analog>
+	>;
+	using to_config = mcutl::gpio::config<
+		as_output<gpiob<0>, out::push_pull, out::one, out::opt::freq_10mhz>,
+		mcutl::gpio::enable_peripherals
+	>;
+	
+	static_assert(mcutl::gpio::transition_cost_v<from_config, to_config>
+		== mcutl::memory::bus_cost { 0u, 2u, 0u } + mcutl::periph::configure_peripheral_cost_v<
+			mcutl::periph::enable<mcutl::periph::gpiob>>);
+	
+	::testing::InSequence s;
+	
+	EXPECT_CALL(memory(), read(addr(&RCC->APB2ENR)));
+	EXPECT_CALL(memory(), write(addr(&RCC->APB2ENR), RCC_APB2ENR_IOPBEN));
+	EXPECT_CALL(memory(), read(addr(&RCC->APB2ENR)));
+	
+	//All CRL bits are known, so no read is required
+	EXPECT_CALL(memory(), write(addr(&GPIOB->CRL), GPIO_CRL_MODE0_0
+		| GPIO_CRL_CNF1_0 | GPIO_CRL_CNF2_0 | GPIO_CRL_CNF3_0
+		| GPIO_CRL_CNF4_0 | GPIO_CRL_CNF5_0 | GPIO_CRL_CNF6_0));
+	EXPECT_CALL(memory(), write(addr(&GPIOB->BSRR), GPIO_BSRR_BS0));
+	mcutl::gpio::transition<from_config, to_config>();
+}
+
+TEST_F(gpio_strict_test_fixture, TransitionExtiTest)
+{
+	::testing::InSequence s;
+	
+	//EXTI8 is connected to PA8
+	constexpr uint32_t initial_exticr3_value = 0xffffffffu & ~AFIO_EXTICR3_EXTI8;
+	memory().set(addr(&(AFIO->EXTICR[2])), initial_exticr3_value);
+	EXPECT_CALL(memory(), read(addr(&(AFIO->EXTICR[2]))));
+	EXPECT_CALL(memory(), write(addr(&(AFIO->EXTICR[2])),
+		initial_exticr3_value | AFIO_EXTICR3_EXTI8_PB));
+	mcutl::gpio::transition<
+		mcutl::gpio::connect_to_exti_line<mcutl::gpio::gpioa<8>>,
+		mcutl::gpio::connect_to_exti_line<mcutl::gpio::gpiob<8>>>();
+}
+
 TEST_F(gpio_strict_test_fixture, SetOutValueTest)
 {
 	EXPECT_CALL(memory(), write(addr(&GPIOD->BSRR), GPIO_BSRR_BS12));
@@ -174,6 +372,147 @@ TEST_F(gpio_strict_test_fixture, SetZeroAtomicTest)
 	mcutl::gpio::set_zero_atomic<mcutl::gpio::gpiog<8>>();
 }
 
+TEST_F(gpio_strict_test_fixture, SetValuesTest)
+{
+	::testing::InSequence s;
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOA->BSRR), GPIO_BSRR_BS1 | GPIO_BSRR_BR2));
+	EXPECT_CALL(memory(), write(addr(&GPIOB->BSRR), GPIO_BSRR_BR2));
+	mcutl::gpio::set_values<
+		mcutl::gpio::to_value<mcutl::gpio::gpioa<1>, mcutl::gpio::out::one>,
+		mcutl::gpio::to_value<mcutl::gpio::gpiob<2>, mcutl::gpio::out::zero>,
+		mcutl::gpio::to_value<mcutl::gpio::gpioa<2>, mcutl::gpio::out::zero>
+	>();
+}
+
+TEST_F(gpio_strict_test_fixture, WriteGroupTest)
+{
+	using mcutl::gpio::gpioa;
+	using mcutl::gpio::gpiob;
+	using mcutl::gpio::gpioc;
+	
+	static_assert(mcutl::gpio::write_group_cost_v<gpioa<3>, gpiob<0>, gpioa<4>, gpioc<15>>
+		== mcutl::memory::bus_cost { 0u, 3u, 0u });
+	
+	::testing::InSequence s;
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOA->BSRR), GPIO_BSRR_BR3 | GPIO_BSRR_BR4));
+	EXPECT_CALL(memory(), write(addr(&GPIOB->BSRR), GPIO_BSRR_BR0 | GPIO_BSRR_BS0));
+	EXPECT_CALL(memory(), write(addr(&GPIOC->BSRR), GPIO_BSRR_BR15 | GPIO_BSRR_BS15));
+	mcutl::gpio::write_group<gpioa<3>, gpiob<0>, gpioa<4>, gpioc<15>>(0b1010u);
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOA->BSRR), GPIO_BSRR_BR3 | GPIO_BSRR_BR4
+		| GPIO_BSRR_BS3 | GPIO_BSRR_BS4));
+	EXPECT_CALL(memory(), write(addr(&GPIOB->BSRR), GPIO_BSRR_BR0));
+	EXPECT_CALL(memory(), write(addr(&GPIOC->BSRR), GPIO_BSRR_BR15));
+	mcutl::gpio::write_group<gpioa<3>, gpiob<0>, gpioa<4>, gpioc<15>>(0b0101u);
+}
+
+TEST_F(gpio_strict_test_fixture, WriteGroupContiguousPinsTest)
+{
+	using mcutl::gpio::gpiob;
+	
+	::testing::InSequence s;
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOB->BSRR), 0xff000000u | 0xa500u));
+	mcutl::gpio::write_group<gpiob<8>, gpiob<9>, gpiob<10>, gpiob<11>,
+		gpiob<12>, gpiob<13>, gpiob<14>, gpiob<15>>(0xa5u);
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOA->BSRR), GPIO_BSRR_BR9 | GPIO_BSRR_BS9));
+	EXPECT_CALL(memory(), write(addr(&GPIOB->BSRR), GPIO_BSRR_BR0 | GPIO_BSRR_BR1 | GPIO_BSRR_BS1));
+	mcutl::gpio::write_group<mcutl::gpio::gpioa<9>, gpiob<0>, gpiob<1>>(0b101u);
+}
+
+namespace
+{
+
+template<typename Bus>
+void expect_parallel_bus_writes(gpio_strict_test_fixture& fixture)
+{
+	using mcutl::gpio::gpioa;
+	using mcutl::gpio::gpiob;
+	
+	//Data bits: 0 - PA9, 1 - PB5, 2 - PA2, 3 - PB0, 4 - PB12, 5 - PA15, 6 - PB13, 7 - PA0
+	constexpr uint32_t gpioa_pins[] { 9, 2, 15, 0 };
+	constexpr uint32_t gpioa_bits[] { 0, 2, 5, 7 };
+	constexpr uint32_t gpiob_pins[] { 5, 0, 12, 13 };
+	constexpr uint32_t gpiob_bits[] { 1, 3, 4, 6 };
+	
+	::testing::InSequence s;
+	for (uint32_t value = 0; value != 256u; ++value)
+	{
+		uint32_t gpioa_bsrr = 0, gpiob_bsrr = 0;
+		for (size_t i = 0; i != std::size(gpioa_pins); ++i)
+		{
+			gpioa_bsrr |= (1u << gpioa_pins[i]) << GPIO_BSRR_BR0_Pos;
+			gpioa_bsrr |= ((value >> gpioa_bits[i]) & 1u) << gpioa_pins[i];
+			gpiob_bsrr |= (1u << gpiob_pins[i]) << GPIO_BSRR_BR0_Pos;
+			gpiob_bsrr |= ((value >> gpiob_bits[i]) & 1u) << gpiob_pins[i];
+		}
+		
+		EXPECT_CALL(fixture.memory(), write(fixture.addr(&GPIOA->BSRR), gpioa_bsrr));
+		EXPECT_CALL(fixture.memory(), write(fixture.addr(&GPIOB->BSRR), gpiob_bsrr));
+		Bus::write(value);
+	}
+}
+
+} //namespace
+
+TEST_F(gpio_strict_test_fixture, ParallelBusTest)
+{
+	using mcutl::gpio::gpioa;
+	using mcutl::gpio::gpiob;
+	using bus = mcutl::gpio::parallel_bus<gpioa<9>, gpiob<5>, gpioa<2>, gpiob<0>,
+		gpiob<12>, gpioa<15>, gpiob<13>, gpioa<0>>;
+	
+	static_assert(bus::width == 8u);
+	static_assert(bus::write_cost == mcutl::memory::bus_cost { 0u, 2u, 0u });
+	static_assert(std::is_same_v<bus::gpio_config<mcutl::gpio::out::opt::freq_10mhz>,
+		mcutl::gpio::config<
+			mcutl::gpio::as_output<gpioa<9>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>,
+			mcutl::gpio::as_output<gpiob<5>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>,
+			mcutl::gpio::as_output<gpioa<2>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>,
+			mcutl::gpio::as_output<gpiob<0>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>,
+			mcutl::gpio::as_output<gpiob<12>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>,
+			mcutl::gpio::as_output<gpioa<15>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>,
+			mcutl::gpio::as_output<gpiob<13>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>,
+			mcutl::gpio::as_output<gpioa<0>, mcutl::gpio::out::push_pull,
+				mcutl::gpio::out::keep_value, mcutl::gpio::out::opt::freq_10mhz>
+		>>);
+	
+	expect_parallel_bus_writes<bus>(*this);
+}
+
+TEST_F(gpio_strict_test_fixture, CompactParallelBusTest)
+{
+	using mcutl::gpio::gpioa;
+	using mcutl::gpio::gpiob;
+	expect_parallel_bus_writes<mcutl::gpio::compact_parallel_bus<gpioa<9>, gpiob<5>, gpioa<2>, gpiob<0>,
+		gpiob<12>, gpioa<15>, gpiob<13>, gpioa<0>>>(*this);
+}
+
+TEST_F(gpio_strict_test_fixture, ParallelBusContiguousPortTest)
+{
+	using mcutl::gpio::gpioc;
+	using mcutl::gpio::gpiod;
+	using bus = mcutl::gpio::parallel_bus<gpioc<13>, gpiod<4>, gpiod<5>, gpiod<6>,
+		gpiod<7>, gpiod<8>, gpiod<9>, gpiod<10>, gpiod<11>, gpioc<0>>;
+	
+	::testing::InSequence s;
+	
+	EXPECT_CALL(memory(), write(addr(&GPIOC->BSRR), GPIO_BSRR_BR0 | GPIO_BSRR_BR13
+		| GPIO_BSRR_BS0 | GPIO_BSRR_BS13));
+	EXPECT_CALL(memory(), write(addr(&GPIOD->BSRR), (0xff0u << GPIO_BSRR_BR0_Pos) | 0x5a0u));
+	bus::write(0x200u | (0x5au << 1u) | 1u);
+}
+
 TEST_F(gpio_strict_test_fixture, GetInputMaskTest)
 {
 	memory().set(addr(&GPIOA->IDR),
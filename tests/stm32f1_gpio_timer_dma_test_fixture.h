@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <ratio>
+#include <stdint.h>
+
+#include "mcutl/clock/clock.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/timer/timer.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+//Fixture for the timer-paced DMA GPIO engines (port_sampler, waveform_generator)
+template<typename Engine, typename OverflowFrequency, typename Word, uint32_t Size>
+class gpio_timer_dma_test_fixture : public mcutl::tests::mcu::flat_test_fixture_base
+{
+public:
+	using clock_config = mcutl::clock::config<mcutl::clock::external_high_speed_crystal<8'000'000>,
+		mcutl::clock::timer2_3_4_5_6_7_12_13_14<mcutl::clock::required_frequency<72'000'000>>>;
+	
+	static constexpr uint32_t buffer_size = Size;
+
+public:
+	void configure()
+	{
+		Engine::template configure<
+			mcutl::timer::overflow_frequency<clock_config, OverflowFrequency, std::ratio<1>>,
+			mcutl::timer::trigger_registers_update,
+			mcutl::timer::base_configuration_is_currently_present
+		>();
+	}
+	
+	void expect_started(const volatile DMA_Channel_TypeDef* channel, const volatile TIM_TypeDef* timer,
+		uint64_t peripheral_address)
+	{
+		EXPECT_EQ(memory().get(addr(&channel->CPAR)), peripheral_address);
+		//The register is 32-bit wide, while the test buffer address may be wider
+		EXPECT_EQ(memory().get(addr(&channel->CMAR)),
+			static_cast<uint32_t>(addr(buffer.data())));
+		EXPECT_EQ(memory().get(addr(&channel->CNDTR)), buffer_size);
+		EXPECT_EQ(memory().get(addr(&channel->CCR)) & DMA_CCR_EN, DMA_CCR_EN);
+		EXPECT_EQ(memory().get(addr(&timer->CR1)) & TIM_CR1_CEN, TIM_CR1_CEN);
+	}
+	
+	void expect_stopped(const volatile DMA_Channel_TypeDef* channel, const volatile TIM_TypeDef* timer)
+	{
+		EXPECT_EQ(memory().get(addr(&timer->CR1)) & TIM_CR1_CEN, 0u);
+		EXPECT_EQ(memory().get(addr(&channel->CCR)) & DMA_CCR_EN, 0u);
+	}
+
+public:
+	std::array<Word, Size> buffer {};
+};
@@ -0,0 +1,135 @@
+#define STM32F103xG
+#define STM32F1
+
+#include <array>
+#include <iterator>
+#include <ratio>
+#include <stdint.h>
+#include <type_traits>
+
+#include "mcutl/dma/dma.h"
+#include "mcutl/gpio/gpio_waveform.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/timer/timer.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include "stm32f1_gpio_timer_dma_test_fixture.h"
+
+namespace
+{
+
+using stepper_pins = mcutl::gpio::waveform_pins<mcutl::gpio::gpioa<8>, mcutl::gpio::gpioa<9>,
+	mcutl::gpio::gpioa<10>, mcutl::gpio::gpioa<11>>;
+using scattered_pins = mcutl::gpio::waveform_pins<mcutl::gpio::gpioc<5>, mcutl::gpio::gpioc<0>,
+	mcutl::gpio::gpioc<13>>;
+
+using generator = mcutl::gpio::waveform_generator<mcutl::timer::timer3, stepper_pins,
+	mcutl::dma::mode::circular,
+	mcutl::dma::interrupt::half_transfer,
+	mcutl::dma::interrupt::transfer_complete>;
+
+constexpr uint32_t table_size = 8u;
+
+} //namespace
+
+TEST(gpio_waveform_test, TraitsTest)
+{
+	EXPECT_EQ(stepper_pins::width, 4u);
+	EXPECT_EQ(stepper_pins::port_letter, 'a');
+	EXPECT_EQ(scattered_pins::width, 3u);
+	EXPECT_EQ(scattered_pins::port_letter, 'c');
+	EXPECT_TRUE((std::is_same_v<stepper_pins::word_type, uint32_t>));
+	
+	EXPECT_TRUE((std::is_same_v<generator::dma_channel, mcutl::dma::dma1<3>>));
+	EXPECT_TRUE((std::is_same_v<generator::timer, mcutl::timer::timer3>));
+	EXPECT_TRUE((std::is_same_v<generator::pins, stepper_pins>));
+	EXPECT_TRUE((std::is_same_v<generator::word_type, uint32_t>));
+	
+	EXPECT_TRUE((std::is_same_v<stepper_pins::gpio_config<>, mcutl::gpio::config<
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<8>, mcutl::gpio::out::push_pull, mcutl::gpio::out::keep_value>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<9>, mcutl::gpio::out::push_pull, mcutl::gpio::out::keep_value>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<10>, mcutl::gpio::out::push_pull, mcutl::gpio::out::keep_value>,
+		mcutl::gpio::as_output<mcutl::gpio::gpioa<11>, mcutl::gpio::out::push_pull, mcutl::gpio::out::keep_value>
+	>>));
+}
+
+TEST(gpio_waveform_test, ToWordTest)
+{
+	static_assert(stepper_pins::to_word(0b0000u) == 0x0f000000u);
+	static_assert(stepper_pins::to_word(0b0101u) == (0x0f000000u | GPIO_BSRR_BS8 | GPIO_BSRR_BS10));
+	static_assert(stepper_pins::to_word(0b1111u) == 0x0f000f00u);
+	static_assert(stepper_pins::to_word(0xfffffff0u) == 0x0f000000u);
+	
+	static_assert(scattered_pins::to_word(0b000u) == 0x20210000u);
+	static_assert(scattered_pins::to_word(0b011u) == (0x20210000u | GPIO_BSRR_BS5 | GPIO_BSRR_BS0));
+	static_assert(scattered_pins::to_word(0b100u) == (0x20210000u | GPIO_BSRR_BS13));
+}
+
+TEST(gpio_waveform_test, MakeTableTest)
+{
+	constexpr auto table = stepper_pins::make_table(std::array<uint8_t, 4> {
+		0b0001, 0b0010, 0b0100, 0b1000 });
+	static_assert(table.size() == 4u);
+	static_assert(table[0] == (0x0f000000u | GPIO_BSRR_BS8));
+	static_assert(table[1] == (0x0f000000u | GPIO_BSRR_BS9));
+	static_assert(table[2] == (0x0f000000u | GPIO_BSRR_BS10));
+	static_assert(table[3] == (0x0f000000u | GPIO_BSRR_BS11));
+}
+
+TEST(gpio_waveform_test, FillTest)
+{
+	const uint16_t pattern[] { 0b100, 0b001, 0b010 };
+	std::array<uint32_t, 4> words {};
+	scattered_pins::fill(words.data() + 1, pattern, std::size(pattern));
+	
+	EXPECT_EQ(words[0], 0u);
+	EXPECT_EQ(words[1], 0x20210000u | GPIO_BSRR_BS13);
+	EXPECT_EQ(words[2], 0x20210000u | GPIO_BSRR_BS5);
+	EXPECT_EQ(words[3], 0x20210000u | GPIO_BSRR_BS0);
+}
+
+class gpio_waveform_test_fixture
+	: public gpio_timer_dma_test_fixture<generator, std::ratio<100'000>, uint32_t, table_size>
+{
+};
+
+TEST_F(gpio_waveform_test_fixture, ConfigureTest)
+{
+	configure();
+	
+	EXPECT_EQ((memory().get(addr(&TIM3->PSC)) + 1u) * (memory().get(addr(&TIM3->ARR)) + 1u), 720u);
+	EXPECT_EQ(memory().get(addr(&TIM3->DIER)), TIM_DIER_UDE);
+	EXPECT_EQ(memory().get(addr(&TIM3->CR1)) & TIM_CR1_CEN, 0u);
+	EXPECT_EQ(memory().get(addr(&DMA1_Channel3->CCR)), DMA_CCR_CIRC | DMA_CCR_MINC | DMA_CCR_DIR
+		| DMA_CCR_PSIZE_1 | DMA_CCR_MSIZE_1 | DMA_CCR_HTIE | DMA_CCR_TCIE);
+}
+
+TEST_F(gpio_waveform_test_fixture, StartStopTest)
+{
+	configure();
+	generator::start(buffer.data(), table_size);
+	expect_started(DMA1_Channel3, TIM3, addr(&GPIOA->BSRR));
+	
+	generator::stop();
+	expect_stopped(DMA1_Channel3, TIM3);
+}
+
+TEST_F(gpio_waveform_test_fixture, FreeHalfTest)
+{
+	memory().set(addr(&DMA1_Channel3->CNDTR), table_size);
+	EXPECT_EQ(generator::get_read_position(table_size), 0u);
+	EXPECT_EQ(generator::get_free_half_offset(table_size), table_size / 2u);
+	
+	memory().set(addr(&DMA1_Channel3->CNDTR), table_size - 3u);
+	EXPECT_EQ(generator::get_read_position(table_size), 3u);
+	EXPECT_EQ(generator::get_free_half_offset(table_size), table_size / 2u);
+	
+	memory().set(addr(&DMA1_Channel3->CNDTR), table_size / 2u);
+	EXPECT_EQ(generator::get_read_position(table_size), table_size / 2u);
+	EXPECT_EQ(generator::get_free_half_offset(table_size), 0u);
+	
+	memory().set(addr(&DMA1_Channel3->CNDTR), 1u);
+	EXPECT_EQ(generator::get_free_half_offset(table_size), 0u);
+}
@@ -35,7 +35,9 @@ public:
 	
 	void expect_flash_latency_change(uint32_t flash_acr_value)
 	{
-		expect_reg_bits_set(addr(&FLASH->ACR), FLASH_ACR_LATENCY, flash_acr_value);
+		//Flash prefetch buffer is enabled by default
+		expect_reg_bits_set(addr(&FLASH->ACR), FLASH_ACR_LATENCY | FLASH_ACR_HLFCYA | FLASH_ACR_PRFTBE,
+			flash_acr_value | FLASH_ACR_PRFTBE);
 	}
 	
 	void expect_set_source_as_system_and_wait(uint32_t source_enable_mask,
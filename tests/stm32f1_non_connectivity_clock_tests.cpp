@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include "mcutl/clock/clock.h"
+#include "mcutl/tests/access_trace.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -40,10 +41,10 @@ TYPED_TEST(min_req_clock_test_fixture_templated, MinimumRequirementsFromBaseConf
 	
 	constexpr auto cfgr_values = RCC_CFGR_PPRE1_DIV2
 		| RCC_CFGR_ADCPRE_DIV6 | RCC_CFGR_PLLMULL16;
+	this->expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	this->expect_reg_bits_set(this->addr(&RCC->CFGR),
 		this->get_cfgr_mask_with_pll(), cfgr_values);
 	this->expect_pll_on_and_wait_ready();
-	this->expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	this->expect_set_pll_as_system_and_wait();
 	
 	this->configure_clocks();
@@ -108,13 +109,15 @@ TEST_F(clock_test_fixture, InternalOscillatorWithUsb)
 	
 	constexpr auto cfgr_values = RCC_CFGR_PPRE1_DIV2
 		| RCC_CFGR_ADCPRE_DIV4 | RCC_CFGR_PLLMULL12 | RCC_CFGR_USBPRE;
+	expect_flash_latency_change(FLASH_ACR_LATENCY_0);
 	this->expect_reg_bits_set(this->addr(&RCC->CFGR),
 		this->get_cfgr_mask_with_pll(), cfgr_values);
 	expect_pll_on_and_wait_ready();
-	expect_flash_latency_change(FLASH_ACR_LATENCY_0);
 	expect_set_pll_as_system_and_wait();
 	
+	mcutl::tests::memory::access_trace trace;
 	mcutl::clock::configure_clocks<internal_osc_with_usb_clock_config>();
+	EXPECT_TRUE(trace.matches_golden("clock_internal_osc_with_usb"));
 }
 
 TEST_F(clock_test_fixture, InternalOscillatorWithUsbTree)
@@ -164,6 +167,49 @@ TEST_F(clock_test_fixture, InternalOscillatorWithUsbTree)
 	EXPECT_FALSE(best_tree.get_config_by_id(clock_id::timer1_8_9_10_11_multiplier).is_used());
 }
 
+TEST(clock_tree_search_test, DominatedTreesArePruned)
+{
+	using clock_id = mcutl::clock::clock_id;
+	using config = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::internal_high_speed_crystal,
+		mcutl::clock::provide_usb_frequency
+	>;
+	constexpr auto best_tree = mcutl::clock::get_best_clock_tree<config>();
+	static_assert(best_tree.is_valid());
+	//PLL source (HSI/2 or HSE prediv) times system clock source (PLL, HSI or HSE)
+	static_assert(best_tree.get_tree_count() == 6u);
+	//Trees with HSI or HSE as the system clock can not beat the 72 MHz PLL tree
+	static_assert(best_tree.get_processed_tree_count() == 2u);
+	
+	EXPECT_EQ(best_tree.get_config_by_id(clock_id::sys).get_exact_frequency(), 72_MHz);
+	EXPECT_EQ(best_tree.get_node_parent(clock_id::sys), clock_id::pll);
+	EXPECT_EQ(best_tree.get_node_parent(clock_id::pll), clock_id::hse_prediv);
+	EXPECT_EQ(best_tree.get_config_by_id(clock_id::usb).get_exact_frequency(), 48_MHz);
+}
+
+TEST(clock_tree_search_test, LowestFrequenciesTreesAreKept)
+{
+	using clock_id = mcutl::clock::clock_id;
+	using config = mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::internal_high_speed_crystal,
+		mcutl::clock::set_lowest_possible_frequencies
+	>;
+	constexpr auto best_tree = mcutl::clock::get_best_clock_tree<config>();
+	static_assert(best_tree.is_valid());
+	//Any tree may reach 8 MHz system clock, so there is nothing to prune
+	static_assert(best_tree.get_processed_tree_count() == best_tree.get_tree_count());
+	
+	//Equal trees do not replace the first one found
+	EXPECT_EQ(best_tree.get_config_by_id(clock_id::sys).get_exact_frequency(), 8_MHz);
+	EXPECT_EQ(best_tree.get_node_parent(clock_id::sys), clock_id::pll);
+	EXPECT_EQ(best_tree.get_node_parent(clock_id::pll), clock_id::hsi_prediv);
+	EXPECT_EQ(best_tree.get_config_by_id(clock_id::ahb).get_exact_frequency(), 2_MHz);
+	EXPECT_EQ(best_tree.get_config_by_id(clock_id::apb1).get_exact_frequency(), 125_KHz);
+	EXPECT_EQ(best_tree.get_config_by_id(clock_id::adc).get_exact_frequency(), 1_MHz);
+}
+
 using external_oscillator_with_usb_clock = mcutl::clock::config<
 	mcutl::clock::external_high_speed_crystal<16_MHz>,
 	mcutl::clock::set_highest_possible_frequencies,
@@ -195,10 +241,10 @@ TYPED_TEST(external_oscillator_with_usb_test_fixture_templated, ExternalOscillat
 		std::is_same_v<typename TestFixture::clock_config_t, external_oscillator_with_usb_clock>
 		? RCC_CR_HSEON : (RCC_CR_HSEON | RCC_CR_HSEBYP)
 	);
+	this->expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	this->expect_reg_bits_set(this->addr(&RCC->CFGR),
 		this->get_cfgr_mask_with_pll(), cfgr_values);
 	this->expect_pll_on_and_wait_ready();
-	this->expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	this->expect_set_pll_as_system_and_wait();
 	this->expect_disable_hsi();
 	
@@ -272,10 +318,10 @@ TEST_F(clock_test_fixture, ExternalOscillatorCoreLimitWithUsb)
 		| RCC_CFGR_ADCPRE_DIV4 | RCC_CFGR_PLLMULL3
 		| RCC_CFGR_PLLSRC | RCC_CFGR_USBPRE;
 	expect_hse_on_and_wait_ready(RCC_CR_HSEON);
+	expect_flash_latency_change(FLASH_ACR_LATENCY_0);
 	expect_reg_bits_set(addr(&RCC->CFGR),
 		get_cfgr_mask_with_pll(), cfgr_values);
 	expect_pll_on_and_wait_ready();
-	expect_flash_latency_change(FLASH_ACR_LATENCY_0);
 	expect_set_pll_as_system_and_wait();
 	expect_disable_hsi();
 	
@@ -299,9 +345,9 @@ TEST_F(clock_test_fixture, NoPllWithCore)
 	InSequence seq;
 	
 	expect_hse_on_and_wait_ready(RCC_CR_HSEON);
+	expect_flash_latency_change(0);
 	expect_reg_bits_set(addr(&RCC->CFGR),
 		get_cfgr_mask_without_pll(), 0);
-	expect_flash_latency_change(0);
 	expect_set_hse_as_system_and_wait();
 	expect_disable_hsi();
 	
@@ -315,6 +361,30 @@ TEST_F(clock_test_fixture, NoPllWithCore)
 	mcutl::clock::configure_clocks<no_pll_with_core_config>();
 }
 
+using half_cycle_flash_access_config = mcutl::clock::config<
+	mcutl::clock::external_high_speed_crystal<8_MHz>,
+	mcutl::clock::base_configuration_is_currently_present,
+	mcutl::clock::force_skip_pll,
+	mcutl::clock::core<mcutl::clock::required_frequency<8_MHz>>,
+	mcutl::clock::enable_flash_half_cycle_access,
+	mcutl::clock::disable_flash_prefetch_buffer
+>;
+
+TEST_F(clock_test_fixture, HalfCycleFlashAccess)
+{
+	InSequence seq;
+	
+	expect_hse_on_and_wait_ready(RCC_CR_HSEON);
+	expect_reg_bits_set(addr(&FLASH->ACR),
+		FLASH_ACR_LATENCY | FLASH_ACR_HLFCYA | FLASH_ACR_PRFTBE, FLASH_ACR_HLFCYA);
+	expect_reg_bits_set(addr(&RCC->CFGR),
+		get_cfgr_mask_without_pll(), 0);
+	expect_set_hse_as_system_and_wait();
+	expect_disable_hsi();
+	
+	mcutl::clock::configure_clocks<half_cycle_flash_access_config>();
+}
+
 using timer1_config_apb2_prescaler1 = mcutl::clock::config<
 	mcutl::clock::external_high_speed_crystal<16_MHz>,
 	mcutl::clock::base_configuration_is_currently_present,
@@ -330,10 +400,10 @@ TEST_F(clock_test_fixture, Timer1ConfigWithApb2Prescaler1)
 		| RCC_CFGR_ADCPRE_DIV6 | RCC_CFGR_PLLMULL9 | RCC_CFGR_PLLXTPRE_HSE_DIV2
 		| RCC_CFGR_PLLSRC;
 	expect_hse_on_and_wait_ready(RCC_CR_HSEON);
+	expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	expect_reg_bits_set(addr(&RCC->CFGR),
 		get_cfgr_mask_with_pll(), cfgr_values);
 	expect_pll_on_and_wait_ready();
-	expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	expect_set_pll_as_system_and_wait();
 	expect_disable_hsi();
 	
@@ -359,10 +429,10 @@ TEST_F(clock_test_fixture, Timer1ConfigWithApb2Prescaler4)
 		| RCC_CFGR_ADCPRE_DIV2 | RCC_CFGR_PLLMULL9 | RCC_CFGR_PLLXTPRE_HSE_DIV2
 		| RCC_CFGR_PLLSRC;
 	expect_hse_on_and_wait_ready(RCC_CR_HSEON);
+	expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	expect_reg_bits_set(addr(&RCC->CFGR),
 		get_cfgr_mask_with_pll(), cfgr_values);
 	expect_pll_on_and_wait_ready();
-	expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	expect_set_pll_as_system_and_wait();
 	expect_disable_hsi();
 	
@@ -435,10 +505,10 @@ TYPED_TEST(spi_test_fixture_templated, Spi)
 	else
 		cfgr_values |= RCC_CFGR_ADCPRE_DIV6;
 	this->expect_hse_on_and_wait_ready(RCC_CR_HSEON);
+	this->expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	this->expect_reg_bits_set(this->addr(&RCC->CFGR),
 		this->get_cfgr_mask_with_pll(), cfgr_values);
 	this->expect_pll_on_and_wait_ready();
-	this->expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	this->expect_set_pll_as_system_and_wait();
 	this->expect_disable_hsi();
 	
@@ -486,10 +556,10 @@ TEST_P(unknown_initial_config_test_fixture, UnknownInitialConfig)
 		| RCC_CFGR_ADCPRE_DIV6 | RCC_CFGR_PLLMULL9 | RCC_CFGR_PLLXTPRE_HSE_DIV2
 		| RCC_CFGR_PLLSRC;
 	expect_hse_on_and_wait_ready(RCC_CR_HSEON);
+	expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	expect_reg_bits_set(addr(&RCC->CFGR),
 		get_cfgr_mask_with_pll(), cfgr_values);
 	expect_pll_on_and_wait_ready();
-	expect_flash_latency_change(FLASH_ACR_LATENCY_1);
 	expect_set_pll_as_system_and_wait();
 	
 	if (GetParam().apb1enr & RCC_APB1ENR_USBEN)
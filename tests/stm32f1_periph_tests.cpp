@@ -410,3 +410,30 @@ TEST_F(periph_strict_test_fixture, ListPeriphTest)
 		mcutl::periph::enable<mcutl::periph::bkp>
 	>();
 }
+
+TEST_F(periph_strict_test_fixture, InitTablePeriphTest)
+{
+	constexpr auto table = mcutl::periph::get_init_table<
+		mcutl::periph::enable<mcutl::types::list<
+			mcutl::periph::pwr,
+			mcutl::periph::bkp
+		>>,
+		mcutl::periph::reset<mcutl::periph::spi1>
+	>();
+	static_assert(table.size() == 3u);
+	
+	auto enr_addr = addr(&(RCC->APB1ENR));
+	auto rst_addr = addr(&(RCC->APB2RSTR));
+	auto mask = RCC_APB1ENR_PWREN | RCC_APB1ENR_BKPEN;
+	memory().set(enr_addr, 0x12345678 & ~mask);
+	memory().set(rst_addr, 0x12345678 & ~RCC_APB2RSTR_SPI1RST);
+	
+	::testing::InSequence s;
+	EXPECT_CALL(memory(), read(enr_addr));
+	EXPECT_CALL(memory(), write(enr_addr, 0x12345678 | mask));
+	EXPECT_CALL(memory(), read(enr_addr));
+	EXPECT_CALL(memory(), read(rst_addr));
+	EXPECT_CALL(memory(), write(rst_addr, 0x12345678 | RCC_APB2RSTR_SPI1RST));
+	
+	mcutl::memory::apply_init_table(table);
+}
@@ -0,0 +1,147 @@
+#define STM32F103xG
+#define STM32F1
+
+#include <sstream>
+#include <stdint.h>
+
+#include "mcutl/adc/adc.h"
+#include "mcutl/clock/clock.h"
+#include "mcutl/dma/dma.h"
+#include "mcutl/rtc/rtc.h"
+#include "mcutl/spi/spi.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/tests/stm32f1_peripheral_models.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+using namespace mcutl::clock::literals;
+namespace models = mcutl::tests::memory::stm32f1;
+
+class peripheral_models_test_fixture : public mcutl::tests::mcu::flat_test_fixture_base
+{
+};
+
+TEST_F(peripheral_models_test_fixture, RccModelTest)
+{
+	memory().set(addr(&RCC->CR), RCC_CR_HSION | RCC_CR_HSIRDY);
+	models::rcc_model rcc(memory(), 3);
+	
+	mcutl::clock::configure_clocks<mcutl::clock::config<
+		mcutl::clock::external_high_speed_crystal<8_MHz>,
+		mcutl::clock::core<mcutl::clock::required_frequency<72_MHz>>,
+		mcutl::clock::base_configuration_is_currently_present
+	>>();
+	
+	EXPECT_EQ(memory().get(addr(&RCC->CR)) & (RCC_CR_HSERDY | RCC_CR_PLLRDY | RCC_CR_HSION),
+		RCC_CR_HSERDY | RCC_CR_PLLRDY);
+	EXPECT_EQ(memory().get(addr(&RCC->CFGR)) & RCC_CFGR_SWS, RCC_CFGR_SWS_PLL);
+	
+	auto hse_stats = rcc.get_wait_statistics("RCC HSERDY");
+	EXPECT_EQ(hse_stats.waits, 1u);
+	EXPECT_EQ(hse_stats.polls, 4u);
+	EXPECT_EQ(rcc.get_wait_statistics("RCC PLLRDY").waits, 1u);
+	EXPECT_EQ(rcc.get_wait_statistics("RCC SWS").waits, 1u);
+	
+	std::ostringstream report;
+	rcc.report(report);
+	EXPECT_NE(report.str().find("RCC HSERDY: 1 waits, 4 polls"), std::string::npos);
+}
+
+TEST_F(peripheral_models_test_fixture, RccModelClockSecurityClearTest)
+{
+	models::rcc_model rcc(memory());
+	memory().set(addr(&RCC->CIR), RCC_CIR_CSSF);
+	
+	mcutl::memory::set_register_bits<RCC_CIR_CSSC_Msk, RCC_CIR_CSSC, &RCC_TypeDef::CIR, RCC_BASE>();
+	EXPECT_EQ(memory().get(addr(&RCC->CIR)), 0u);
+	EXPECT_FALSE((mcutl::memory::get_register_flag<RCC_CIR_CSSF, &RCC_TypeDef::CIR, RCC_BASE>()));
+}
+
+TEST_F(peripheral_models_test_fixture, RtcModelTest)
+{
+	models::rcc_model rcc(memory());
+	models::rtc_model rtc(memory());
+	
+	mcutl::rtc::configure<
+		mcutl::rtc::clock::internal,
+		mcutl::rtc::clock::one_second_prescaler,
+		mcutl::rtc::enable<true>,
+		mcutl::rtc::base_configuration_is_currently_present
+	>();
+	
+	EXPECT_EQ(memory().get(addr(&RTC->PRLL)), 40000u);
+	EXPECT_EQ(memory().get(addr(&RTC->CRL)) & (RTC_CRL_RTOFF | RTC_CRL_RSF | RTC_CRL_CNF),
+		RTC_CRL_RTOFF | RTC_CRL_RSF);
+	EXPECT_EQ(rcc.get_wait_statistics("RCC LSIRDY").waits, 1u);
+	EXPECT_EQ(rtc.get_wait_statistics("RTC RSF").waits, 1u);
+	EXPECT_GE(rtc.get_wait_statistics("RTC RTOFF").waits, 1u);
+}
+
+TEST_F(peripheral_models_test_fixture, DmaModelTest)
+{
+	models::dma_model dma(memory(), 5);
+	memory().set(addr(&DMA2_Channel3->CCR), DMA_CCR_EN | DMA_CCR_MINC | DMA_CCR_PINC);
+	uint8_t from[4] {};
+	uint8_t to[4] {};
+	
+	mcutl::dma::start_transfer<mcutl::dma::dma2<3>>(from, to, sizeof(from));
+	EXPECT_EQ(memory().get(addr(&DMA2_Channel3->CNDTR)), sizeof(from));
+	mcutl::dma::wait_transfer<mcutl::dma::dma2<3>>();
+	
+	EXPECT_EQ(memory().get(addr(&DMA2_Channel3->CNDTR)), 0u);
+	EXPECT_EQ(memory().get(addr(&DMA2->ISR)), DMA_ISR_GIF3 | DMA_ISR_TCIF3);
+	EXPECT_EQ(dma.get_wait_statistics("DMA2 channel 3").polls, 6u);
+	
+	mcutl::dma::clear_pending_flags<mcutl::dma::dma2<3>,
+		mcutl::dma::interrupt::transfer_complete>();
+	EXPECT_FALSE((mcutl::memory::get_register_flag<DMA_ISR_TCIF3, &DMA_TypeDef::ISR, DMA2_BASE>()));
+}
+
+TEST_F(peripheral_models_test_fixture, DmaModelClearBeforeStartTest)
+{
+	models::dma_model dma(memory());
+	memory().set(addr(&DMA1_Channel4->CCR), DMA_CCR_EN | DMA_CCR_MINC | DMA_CCR_PINC);
+	memory().set(addr(&DMA1->ISR), DMA_ISR_GIF4 | DMA_ISR_TCIF4);
+	uint8_t from[4] {};
+	uint8_t to[4] {};
+	
+	mcutl::dma::clear_pending_flags<mcutl::dma::dma1<4>,
+		mcutl::dma::interrupt::global, mcutl::dma::interrupt::transfer_complete>();
+	EXPECT_EQ(memory().get(addr(&DMA1->ISR)), 0u);
+	
+	mcutl::dma::start_transfer<mcutl::dma::dma1<4>>(from, to, sizeof(from));
+	mcutl::dma::wait_transfer<mcutl::dma::dma1<4>>();
+	
+	EXPECT_EQ(memory().get(addr(&DMA1->ISR)), DMA_ISR_GIF4 | DMA_ISR_TCIF4);
+	EXPECT_TRUE((mcutl::memory::get_register_flag<DMA_ISR_TCIF4, &DMA_TypeDef::ISR, DMA1_BASE>()));
+}
+
+TEST_F(peripheral_models_test_fixture, AdcModelTest)
+{
+	models::adc_model adc(memory());
+	memory().set(addr(&ADC2->CR2), ADC_CR2_ADON);
+	
+	mcutl::adc::calibrate<mcutl::adc::adc2>();
+	while (!mcutl::adc::is_calibration_finished<mcutl::adc::adc2>())
+	{
+	}
+	
+	EXPECT_EQ(adc.get_wait_statistics("ADC2 CAL").waits, 1u);
+	EXPECT_EQ(memory().get(addr(&ADC2->CR2)), ADC_CR2_ADON);
+}
+
+TEST_F(peripheral_models_test_fixture, SpiModelTest)
+{
+	models::spi_model spi(memory(), 4);
+	
+	mcutl::memory::set_register_value<0x12u, &SPI_TypeDef::DR, SPI2_BASE>();
+	EXPECT_FALSE((mcutl::memory::get_register_flag<SPI_SR_TXE, &SPI_TypeDef::SR, SPI2_BASE>()));
+	EXPECT_TRUE((mcutl::memory::get_register_flag<SPI_SR_BSY, &SPI_TypeDef::SR, SPI2_BASE>()));
+	while (!mcutl::memory::get_register_flag<SPI_SR_TXE, &SPI_TypeDef::SR, SPI2_BASE>())
+	{
+	}
+	
+	EXPECT_EQ(memory().get(addr(&SPI2->SR)), SPI_SR_TXE | SPI_SR_RXNE);
+	EXPECT_EQ(spi.get_wait_statistics("SPI2 TXE").polls, 5u);
+}
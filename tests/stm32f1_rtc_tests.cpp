@@ -7,6 +7,7 @@
 #include "mcutl/interrupt/interrupt.h"
 #include "mcutl/periph/periph_defs.h"
 #include "mcutl/rtc/rtc.h"
+#include "mcutl/tests/access_trace.h"
 #include "mcutl/tests/mcu.h"
 #include "mcutl/utils/duration.h"
 #include "mcutl/utils/type_helpers.h"
@@ -484,12 +485,14 @@ TEST_F(rtc_strict_test_fixture, ConfigureWithBaseConfigComplexTest1)
 	expect_set_bdcr(RCC_BDCR_RTCSEL_LSI | RCC_BDCR_RTCEN);
 	expect_disable_backup_writes(true, false);
 	
+	mcutl::tests::memory::access_trace trace;
 	mcutl::rtc::configure<
 		mcutl::rtc::clock::internal,
 		mcutl::rtc::clock::one_second_prescaler,
 		mcutl::rtc::enable<true>,
 		mcutl::rtc::base_configuration_is_currently_present
 	>();
+	EXPECT_TRUE(trace.matches_golden("rtc_configure_lsi_one_second"));
 }
 
 TEST_F(rtc_strict_test_fixture, ConfigureWithBaseConfigComplexTest2)
@@ -0,0 +1,242 @@
+#define STM32F103xG
+#define STM32F1
+
+#include <stdint.h>
+#include <vector>
+
+#include "mcutl/dma/dma.h"
+#include "mcutl/instruction/instruction.h"
+#include "mcutl/interrupt/interrupt.h"
+#include "mcutl/systick/systick.h"
+#include "mcutl/systick/systick_wait.h"
+#include "mcutl/tests/mcu.h"
+#include "mcutl/tests/stm32f1_simulator.h"
+#include "mcutl/timer/timer.h"
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+namespace simulation = mcutl::tests::simulation;
+
+class simulator_test_fixture : public mcutl::tests::mcu::flat_test_fixture_base
+{
+public:
+	virtual void SetUp() override
+	{
+		mcutl::tests::mcu::flat_test_fixture_base::SetUp();
+		simulator_ = std::make_unique<simulation::stm32f1::mcu_simulator>(memory(), instruction());
+	}
+	
+	virtual void TearDown() override
+	{
+		simulator_.reset();
+		mcutl::tests::mcu::flat_test_fixture_base::TearDown();
+	}
+	
+	[[nodiscard]] simulation::stm32f1::mcu_simulator& sim() noexcept
+	{
+		return *simulator_;
+	}
+
+private:
+	std::unique_ptr<simulation::stm32f1::mcu_simulator> simulator_;
+};
+
+TEST_F(simulator_test_fixture, SysTickCountsDownTest)
+{
+	mcutl::systick::set_reload_value(999u);
+	mcutl::systick::reset_value();
+	mcutl::systick::configure<
+		mcutl::systick::clock_source::processor,
+		mcutl::systick::enable<true>
+	>();
+	
+	sim().advance(501);
+	//Reload takes one tick after VAL is reset to zero
+	EXPECT_EQ(memory().get(addr(&SysTick->VAL)), 999u - 500u);
+	EXPECT_FALSE(mcutl::systick::has_overflown());
+	
+	sim().advance(1000);
+	EXPECT_TRUE(mcutl::systick::has_overflown());
+	EXPECT_FALSE(mcutl::systick::has_overflown());
+}
+
+TEST_F(simulator_test_fixture, SysTickWaitMsecTest)
+{
+	mcutl::systick::set_reload_value(mcutl::systick::get_default_reload_value());
+	mcutl::systick::reset_value();
+	mcutl::systick::configure<
+		mcutl::systick::clock_source::processor,
+		mcutl::systick::enable<true>
+	>();
+	
+	auto cycles = sim().measure([] { mcutl::systick::wait_msec<8'000'000u, 2u>(); });
+	EXPECT_GE(cycles, 16'000u);
+	EXPECT_LE(cycles, 16'000u + 16u);
+}
+
+TEST_F(simulator_test_fixture, SysTickInterruptTest)
+{
+	uint32_t ticks = 0;
+	sim().set_handler<mcutl::interrupt::type::systick>([&ticks] {
+		EXPECT_TRUE(mcutl::interrupt::is_interrupt_context());
+		++ticks;
+	});
+	
+	mcutl::systick::set_reload_value(99u);
+	mcutl::systick::reset_value();
+	mcutl::systick::configure<
+		mcutl::systick::clock_source::external,
+		mcutl::systick::enable<true>,
+		mcutl::systick::interrupt::tick
+	>();
+	
+	sim().advance(8u * 100u * 3u);
+	EXPECT_EQ(ticks, 3u);
+	EXPECT_EQ(sim().get_interrupt_count<mcutl::interrupt::type::systick>(), 3u);
+	EXPECT_FALSE(mcutl::interrupt::is_interrupt_context());
+}
+
+TEST_F(simulator_test_fixture, TimerOverflowSleepTest)
+{
+	std::vector<simulation::cycle_type> overflows;
+	sim().set_handler<mcutl::interrupt::type::tim2>([this, &overflows] {
+		overflows.push_back(sim().get_cycles());
+		mcutl::timer::clear_pending_flags<mcutl::timer::timer2,
+			mcutl::timer::interrupt::overflow>();
+	});
+	
+	mcutl::timer::configure<mcutl::timer::timer2,
+		mcutl::timer::prescaler<8>,
+		mcutl::timer::reload_value<1000>,
+		mcutl::timer::enable<true>,
+		mcutl::timer::interrupt::overflow,
+		mcutl::timer::interrupt::enable_controller_interrupts,
+		mcutl::timer::base_configuration_is_currently_present
+	>();
+	
+	auto start = sim().get_cycles();
+	mcutl::instruction::execute<mcutl::device::instruction::type::wfi>();
+	mcutl::instruction::execute<mcutl::device::instruction::type::wfi>();
+	
+	ASSERT_EQ(overflows.size(), 2u);
+	EXPECT_LE(overflows[0] - start, 8'000u);
+	EXPECT_EQ(overflows[1] - overflows[0], 8'000u);
+	EXPECT_FALSE((mcutl::timer::get_pending_flags<mcutl::timer::timer2,
+		mcutl::timer::interrupt::overflow>()));
+}
+
+TEST_F(simulator_test_fixture, InterruptMaskTest)
+{
+	uint32_t overflows = 0;
+	sim().set_handler<mcutl::interrupt::type::tim3>([&overflows] {
+		mcutl::timer::clear_pending_flags<mcutl::timer::timer3,
+			mcutl::timer::interrupt::overflow>();
+		++overflows;
+	});
+	
+	mcutl::instruction::execute<mcutl::device::instruction::type::cpsid_i>();
+	mcutl::timer::configure<mcutl::timer::timer3,
+		mcutl::timer::reload_value<99>,
+		mcutl::timer::enable<true>,
+		mcutl::timer::interrupt::overflow,
+		mcutl::timer::interrupt::enable_controller_interrupts,
+		mcutl::timer::base_configuration_is_currently_present
+	>();
+	
+	mcutl::instruction::execute<mcutl::device::instruction::type::wfi>();
+	EXPECT_EQ(overflows, 0u);
+	EXPECT_TRUE(mcutl::interrupt::is_pending<mcutl::interrupt::type::tim3>());
+	
+	mcutl::instruction::execute<mcutl::device::instruction::type::cpsie_i>();
+	EXPECT_EQ(overflows, 1u);
+	EXPECT_FALSE(mcutl::interrupt::is_pending<mcutl::interrupt::type::tim3>());
+}
+
+TEST_F(simulator_test_fixture, DmaMemoryToMemoryTest)
+{
+	uint16_t from[8] { 1, 2, 3, 4, 5, 6, 7, 8 };
+	uint32_t to[8] {};
+	sim().map_buffer(from, sizeof(from));
+	sim().map_buffer(to, sizeof(to));
+	
+	mcutl::dma::configure_channel<mcutl::dma::dma2<1>,
+		mcutl::dma::source<mcutl::dma::data_size::halfword,
+			mcutl::dma::address::memory, mcutl::dma::pointer_increment::enabled>,
+		mcutl::dma::destination<mcutl::dma::data_size::word,
+			mcutl::dma::address::memory, mcutl::dma::pointer_increment::enabled>
+	>();
+	
+	auto cycles = sim().measure([&] {
+		mcutl::dma::start_transfer<mcutl::dma::dma2<1>>(from, to, 8u);
+		mcutl::dma::wait_transfer<mcutl::dma::dma2<1>>();
+	});
+	
+	for (uint32_t i = 0; i != 8; ++i)
+		EXPECT_EQ(to[i], from[i]);
+	EXPECT_GE(cycles, 8u * 4u);
+	EXPECT_TRUE(memory().get(addr(&DMA2->ISR)) & DMA_ISR_TCIF1);
+}
+
+TEST_F(simulator_test_fixture, DmaSpiTransmitTest)
+{
+	constexpr uint32_t cycles_per_byte = 64;
+	uint8_t data[6] { 0x10, 0x20, 0x30, 0x40, 0x50, 0x60 };
+	std::vector<uint8_t> transmitted;
+	sim().map_buffer(data, sizeof(data));
+	sim().set_peripheral_sink(addr(&SPI1->DR),
+		[&transmitted] (uint64_t value) { transmitted.push_back(static_cast<uint8_t>(value)); });
+	sim().dma1().set_channel_period(3, cycles_per_byte);
+	
+	uint32_t completions = 0;
+	sim().set_handler<mcutl::interrupt::type::dma1_ch3>([&completions] {
+		mcutl::dma::clear_pending_flags<mcutl::dma::dma1<3>,
+			mcutl::dma::interrupt::transfer_complete>();
+		++completions;
+	});
+	
+	mcutl::dma::configure_channel<mcutl::dma::dma1<3>,
+		mcutl::dma::interrupt::transfer_complete,
+		mcutl::dma::interrupt::enable_controller_interrupts,
+		mcutl::dma::source<mcutl::dma::data_size::byte,
+			mcutl::dma::address::memory, mcutl::dma::pointer_increment::enabled>,
+		mcutl::dma::destination<mcutl::dma::data_size::byte,
+			mcutl::dma::address::peripheral, mcutl::dma::pointer_increment::disabled>
+	>();
+	
+	auto cycles = sim().measure([&] {
+		mcutl::dma::start_transfer<mcutl::dma::dma1<3>>(data, &SPI1->DR, sizeof(data));
+		mcutl::instruction::execute<mcutl::device::instruction::type::wfi>();
+	});
+	
+	EXPECT_EQ(transmitted, std::vector<uint8_t>(std::begin(data), std::end(data)));
+	EXPECT_EQ(completions, 1u);
+	EXPECT_GE(cycles, sizeof(data) * cycles_per_byte);
+	EXPECT_LE(cycles, sizeof(data) * cycles_per_byte + 64u);
+}
+
+TEST_F(simulator_test_fixture, DmaAdcScanCircularTest)
+{
+	uint16_t samples[4] {};
+	uint16_t next_sample = 100;
+	sim().map_buffer(samples, sizeof(samples));
+	sim().set_peripheral_source(addr(&ADC1->DR), [&next_sample] { return next_sample++; });
+	sim().dma1().set_channel_period(1, 14);
+	
+	mcutl::dma::configure_channel<mcutl::dma::dma1<1>,
+		mcutl::dma::mode::circular,
+		mcutl::dma::source<mcutl::dma::data_size::halfword,
+			mcutl::dma::address::peripheral, mcutl::dma::pointer_increment::disabled>,
+		mcutl::dma::destination<mcutl::dma::data_size::halfword,
+			mcutl::dma::address::memory, mcutl::dma::pointer_increment::enabled>
+	>();
+	mcutl::dma::start_transfer<mcutl::dma::dma1<1>>(&ADC1->DR, samples, 4u);
+	
+	sim().advance(14u * 6u);
+	EXPECT_EQ(samples[0], 104u);
+	EXPECT_EQ(samples[1], 105u);
+	EXPECT_EQ(samples[2], 102u);
+	EXPECT_EQ(samples[3], 103u);
+	EXPECT_EQ(memory().get(addr(&DMA1->ISR)) & (DMA_ISR_GIF1 | DMA_ISR_TCIF1 | DMA_ISR_HTIF1),
+		DMA_ISR_GIF1 | DMA_ISR_TCIF1 | DMA_ISR_HTIF1);
+}
@@ -9,6 +9,7 @@
 #include "mcutl/interrupt/interrupt.h"
 #include "mcutl/periph/periph.h"
 #include "mcutl/spi/spi.h"
+#include "mcutl/tests/access_counter.h"
 #include "mcutl/tests/mcu.h"
 #include "mcutl/utils/type_helpers.h"
 
@@ -472,6 +473,21 @@ TYPED_TEST(spi_list_test_fixture, DmaTransmitTest)
 	spi16.transmit(this->uint16_t_tx_data, this->data_length);
 }
 
+TYPED_TEST(spi_list_test_fixture, DmaTransmitAccessBudgetTest)
+{
+	constexpr uint32_t initial_cr2 = 0xffffffff;
+	this->memory().set(this->addr(&this->spi_reg()->CR2), initial_cr2);
+	this->memory().allow_reads(this->addr(&this->spi_reg()->CR2));
+	
+	this->expect_spi_dma_transmit(this->uint8_t_tx_data, this->data_length);
+	
+	mcutl::tests::memory::access_counter counter;
+	auto spi8 = this->create_dma_spi();
+	EXPECT_TRUE(counter.within_budget("spi::master::transmit", 8u, [&spi8, this] {
+		spi8.transmit(this->uint8_t_tx_data, this->data_length);
+	}));
+}
+
 TYPED_TEST(spi_list_test_fixture, DmaTransmitReceiveTest)
 {
 	constexpr uint32_t initial_cr2 = 0xffffffff & ~SPI_CR2_RXDMAEN;
@@ -239,6 +239,32 @@ TYPED_TEST(timer_list_test_fixture, ConfigureWithBaseConfigurationTest3)
 		mcutl::timer::base_configuration_is_currently_present>();
 }
 
+TYPED_TEST(timer_list_test_fixture, InitTableTest)
+{
+	using timer = typename TestFixture::timer;
+	
+	constexpr auto table = mcutl::timer::get_init_table<timer,
+		mcutl::timer::enable_peripheral<true>,
+		mcutl::timer::direction::down,
+		mcutl::timer::master_mode::output_update,
+		mcutl::timer::reload_value<60000>,
+		mcutl::timer::interrupt::overflow,
+		mcutl::timer::enable<true>>();
+	static_assert(table.size() == 8u);
+	
+	::testing::InSequence s;
+	this->expect_enable_peripheral();
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->CR1), TIM_CR1_DIR));
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->CR2), TIM_CR2_MMS_1));
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->PSC), 0u));
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->ARR), 59999u));
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->DIER), TIM_DIER_UIE));
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->CR1),
+		TIM_CR1_DIR | TIM_CR1_CEN));
+	
+	mcutl::memory::apply_init_table(table);
+}
+
 TYPED_TEST(timer_list_test_fixture, ConfigureWithBaseConfigurationTest4)
 {
 	using timer = typename TestFixture::timer;
@@ -592,3 +618,69 @@ TYPED_TEST(timer_list_test_fixture, ReconfigureTest8)
 	mcutl::timer::reconfigure<timer,
 		mcutl::timer::interrupt::disable_controller_interrupts>();
 }
+
+TYPED_TEST(timer_list_test_fixture, ConfigureUpdateDmaRequestTest)
+{
+	using timer = typename TestFixture::timer;
+	
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->DIER),
+		TIM_DIER_UIE | TIM_DIER_UDE));
+	
+	mcutl::timer::configure<timer,
+		mcutl::timer::interrupt::overflow,
+		mcutl::timer::update_dma_request<true>,
+		mcutl::timer::base_configuration_is_currently_present>();
+	
+	constexpr auto table = mcutl::timer::get_init_table<timer,
+		mcutl::timer::update_dma_request<true>,
+		mcutl::timer::base_configuration_is_currently_present>();
+	static_assert(table.size() == 1u);
+	
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->DIER), TIM_DIER_UDE));
+	mcutl::memory::apply_init_table(table);
+}
+
+TYPED_TEST(timer_list_test_fixture, ReconfigureUpdateDmaRequestTest)
+{
+	using timer = typename TestFixture::timer;
+	
+	static constexpr uint32_t initial_dier = 0xffffffffu & ~TIM_DIER_UDE;
+	
+	this->memory().allow_reads(this->addr(&this->timer_reg()->DIER));
+	this->memory().set(this->addr(&this->timer_reg()->DIER), initial_dier);
+	
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->DIER),
+		initial_dier | TIM_DIER_UDE));
+	
+	mcutl::timer::reconfigure<timer,
+		mcutl::timer::update_dma_request<true>>();
+	
+	this->memory().set(this->addr(&this->timer_reg()->DIER), 0xffffffffu);
+	
+	EXPECT_CALL(this->memory(), write(this->addr(&this->timer_reg()->DIER),
+		0xffffffffu & ~(TIM_DIER_UDE | TIM_DIER_UIE)));
+	
+	mcutl::timer::reconfigure<timer,
+		mcutl::interrupt::disabled<mcutl::timer::interrupt::overflow>,
+		mcutl::timer::update_dma_request<false>>();
+}
+
+TEST(timer_test, UpdateDmaChannelTest)
+{
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer1>,
+		mcutl::dma::dma1<5>>));
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer2>,
+		mcutl::dma::dma1<2>>));
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer3>,
+		mcutl::dma::dma1<3>>));
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer4>,
+		mcutl::dma::dma1<7>>));
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer5>,
+		mcutl::dma::dma2<2>>));
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer6>,
+		mcutl::dma::dma2<3>>));
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer7>,
+		mcutl::dma::dma2<4>>));
+	EXPECT_TRUE((std::is_same_v<mcutl::timer::update_dma_channel<mcutl::timer::timer8>,
+		mcutl::dma::dma2<1>>));
+}